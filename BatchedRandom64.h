@@ -0,0 +1,91 @@
+#pragma once
+
+#include <stddef.h>
+
+#include "IntMath.h"
+#include "Random.h"
+
+/* Batched bounded random */
+/* Reference: Brackett-Rozinsky & Lemire, "Batched Ranged Random Integer Generation" */
+
+// Multiplying the draw by each range in turn yields the mixed-radix digits of
+// floor(x * product / 2^64) in the high words. The final low word equals
+// x * product mod 2^64, so one Multiply-style rejection check covers the whole batch.
+
+#define BATCH64_MAX_COUNT 16
+
+// Batches built by rand64_bounded_descending keep their product below this limit,
+// which keeps the rejection chance of a batch under 2^-8.
+#define BATCH64_PRODUCT_LIMIT ((uint64_t)1 << 56)
+
+static uint64_t rand64_batch_chain(uint64_t x, const uint64_t aRange[], uint64_t aResult[], size_t count) {
+	uint64_t m[2];
+	for (size_t i = 0; i < count; ++i) {
+		mul_u64(x, aRange[i], &m);
+		aResult[i] = m[1];
+		x = m[0];
+	}
+	return x;
+}
+
+static void rand64_bounded_batch_product(rand64_func_t rand64_function, rand64_state* state, const uint64_t aRange[], uint64_t aResult[], size_t count, uint64_t product) {
+	uint64_t low = rand64_batch_chain(rand64_function(state), aRange, aResult, count);
+	if (low < product) {
+		uint64_t t = 0 - product;
+		if (t >= product) {
+			t -= product;
+			if (t >= product)
+				t %= product;
+		}
+		while (low < t)
+			low = rand64_batch_chain(rand64_function(state), aRange, aResult, count);
+	}
+}
+
+// aResult[i] is in [0, aRange[i]). Every range must be at least 1 and their product must fit in 64 bits.
+static void rand64_bounded_batch(rand64_func_t rand64_function, rand64_state* state, const uint64_t aRange[], uint64_t aResult[], size_t count) {
+	uint64_t product = 1;
+	for (size_t i = 0; i < count; ++i)
+		product *= aRange[i];
+	rand64_bounded_batch_product(rand64_function, state, aRange, aResult, count, product);
+}
+
+// aResult[i] is in [0, first_range - i), i.e. the Fisher-Yates steps first_range, first_range - 1, ...
+// count must not exceed first_range. The batch size is chosen from the ranges: large ranges get one per draw.
+static void rand64_bounded_descending(rand64_func_t rand64_function, rand64_state* state, uint64_t first_range, uint64_t aResult[], size_t count) {
+	uint64_t aRange[BATCH64_MAX_COUNT];
+	size_t i = 0;
+	while (i < count) {
+		uint64_t product = first_range - i;
+		size_t k = 1;
+		aRange[0] = product;
+		while (k < BATCH64_MAX_COUNT && i + k < count) {
+			uint64_t range = first_range - i - k;
+			uint64_t m[2];
+			mul_u64(product, range, &m);
+			if (m[1] != 0 || m[0] > BATCH64_PRODUCT_LIMIT)
+				break;
+			product = m[0];
+			aRange[k++] = range;
+		}
+		rand64_bounded_batch_product(rand64_function, state, aRange, aResult + i, k, product);
+		i += k;
+	}
+}
+
+// Fisher-Yates shuffle drawing its swap indices in batches.
+static void shuffle64_batched(rand64_func_t rand64_function, rand64_state* state, uint64_t aArray[], size_t n) {
+	uint64_t aIndex[BATCH64_MAX_COUNT];
+	size_t i = n;
+	while (i > 1) {
+		size_t count = (i - 1 < BATCH64_MAX_COUNT) ? i - 1 : BATCH64_MAX_COUNT;
+		rand64_bounded_descending(rand64_function, state, i, aIndex, count);
+		for (size_t j = 0; j < count; ++j) {
+			size_t last = i - 1 - j;
+			uint64_t temp = aArray[last];
+			aArray[last] = aArray[aIndex[j]];
+			aArray[aIndex[j]] = temp;
+		}
+		i -= count;
+	}
+}
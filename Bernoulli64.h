@@ -0,0 +1,109 @@
+#pragma once
+
+#include <math.h>
+#include <stddef.h>
+
+#include "IntMath.h"
+#include "Random.h"
+
+/* Bernoulli subset selection: keep each of n items with probability p */
+
+// The probability is stored as a 0.64 fixed-point threshold T (p = T / 2^64).
+// Let 2^-k be the smallest power of two >= p.
+//
+// Dense (k <= BERNOULLI64_DENSE_MAX_SHIFT): the AND of k words has each bit set with
+// probability 2^-k (every bit when k = 0, i.e. p > 1/2), so candidates come 64 items at
+// a time and are walked with bsf_u64. If p is not a power of two, each candidate is kept
+// when a fresh word is below T << k, which is exact.
+//
+// Sparse: the gap to the next kept item is geometric and drawn by inversion,
+// floor(log(U) / log(1 - p)) with a 53-bit U, so the cost is per kept item instead of
+// per item. This path is not exact: for every p, powers of two included, the gap
+// distribution is only as accurate as double rounding of the logarithm, and there is no
+// log2_u64 / bsf_u64 fast path for p = 2^-k below the dense range. Exact geometric
+// samplers with constant expected cost per kept item exist (Bringmann & Friedrich), but
+// they evaluate (1 - p)^m with multi-precision arithmetic on demand, which is not
+// implemented here.
+
+#define BERNOULLI64_DENSE_MAX_SHIFT 6
+
+typedef struct {
+	uint64_t Threshold;
+	uint64_t CandidateThreshold; // T << k, 0 if p is a power of two
+	uint8_t Shift;               // k
+	double InvLogQ;              // 1 / log(1 - p)
+} bernoulli64_t;
+
+// 0 < p < 1
+static void bernoulli64_init(bernoulli64_t* sampler, double p) {
+	uint64_t T = (uint64_t)ldexp(p, 64);
+	if (T == 0)
+		T = 1;
+	uint8_t Log = log2_u64(T);
+
+	sampler->Threshold = T;
+	if (Log == bsf_u64(T)) {
+		sampler->Shift = 64 - Log;
+		sampler->CandidateThreshold = 0;
+	} else {
+		sampler->Shift = 63 - Log;
+		sampler->CandidateThreshold = T << sampler->Shift;
+	}
+	sampler->InvLogQ = 1.0 / log1p(-ldexp((double)T, -64));
+}
+
+static size_t bernoulli64_select_dense(const bernoulli64_t* sampler, rand64_func_t rand64_function, rand64_state* state, uint64_t* pNext, uint64_t n, uint64_t aIndex[], size_t capacity) {
+	uint64_t base = *pNext;
+	size_t count = 0;
+	while (base < n) {
+		uint64_t mask = UINT64_MAX;
+		for (uint8_t i = 0; i < sampler->Shift; ++i)
+			mask &= rand64_function(state);
+		if (n - base < 64)
+			mask &= UINT64_MAX >> (64 - (n - base));
+
+		while (mask != 0) {
+			uint64_t index = base + bsf_u64(mask);
+			mask &= mask - 1;
+			if (sampler->CandidateThreshold != 0 && rand64_function(state) >= sampler->CandidateThreshold)
+				continue;
+
+			aIndex[count++] = index;
+			if (count == capacity) {
+				// Bits past index were drawn but not looked at, so dropping them keeps the result exact.
+				*pNext = index + 1;
+				return count;
+			}
+		}
+		base += 64;
+	}
+	*pNext = n;
+	return count;
+}
+
+static size_t bernoulli64_select_sparse(const bernoulli64_t* sampler, rand64_func_t rand64_function, rand64_state* state, uint64_t* pNext, uint64_t n, uint64_t aIndex[], size_t capacity) {
+	uint64_t index = *pNext;
+	size_t count = 0;
+	while (count < capacity) {
+		// U in (0, 1]
+		double U = (double)((rand64_function(state) >> 11) + 1) * 0x1p-53;
+		double Gap = floor(log(U) * sampler->InvLogQ);
+		if (Gap >= (double)(n - index)) {
+			*pNext = n;
+			return count;
+		}
+		index += (uint64_t)Gap;
+		aIndex[count++] = index++;
+	}
+	*pNext = index;
+	return count;
+}
+
+// Writes the kept indices in [*pNext, n) to aIndex in increasing order, at most capacity of them.
+// *pNext is updated to where to resume, n when all items are done.
+static size_t bernoulli64_select(const bernoulli64_t* sampler, rand64_func_t rand64_function, rand64_state* state, uint64_t* pNext, uint64_t n, uint64_t aIndex[], size_t capacity) {
+	if (sampler->Shift <= BERNOULLI64_DENSE_MAX_SHIFT)
+		return bernoulli64_select_dense(sampler, rand64_function, state, pNext, n, aIndex, capacity);
+	else
+		return bernoulli64_select_sparse(sampler, rand64_function, state, pNext, n, aIndex, capacity);
+}
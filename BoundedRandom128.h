@@ -0,0 +1,96 @@
+#pragma once
+
+#include "BoundedRandom64.h"
+#include "IntMath.h"
+#include "Random.h"
+
+// 128-bit values are stored as 64-bit words, least significant first.
+// Ranges that fit in 64 bits are handed to the 64-bit algorithms, which need a single RNG call.
+
+static inline uint8_t less_u128(const uint64_t A[2], const uint64_t B[2]) {
+	return (A[1] < B[1]) || (A[1] == B[1] && A[0] < B[0]);
+}
+
+static inline void sub_u128(uint64_t (*pA)[2], const uint64_t B[2]) {
+	uint8_t Borrow = ((*pA)[0] < B[0]);
+	(*pA)[0] -= B[0];
+	(*pA)[1] -= B[1] + Borrow;
+}
+
+static void rand128_bounded_bitmask(rand64_func_t rand64_function, rand64_state* state, const uint64_t max_value[2], uint64_t (*pResult)[2]) {
+	if (max_value[1] == 0) {
+		(*pResult)[0] = rand64_bounded_bitmask(rand64_function, state, max_value[0]);
+		(*pResult)[1] = 0;
+		return;
+	}
+
+	uint64_t mask = UINT64_MAX >> (63 - log2_u64(max_value[1]));
+	do {
+		(*pResult)[0] = rand64_function(state);
+		(*pResult)[1] = rand64_function(state) & mask;
+	} while (less_u128(max_value, *pResult));
+}
+
+static void rand128_bounded_multiply(rand64_func_t rand64_function, rand64_state* state, const uint64_t max_value[2], uint64_t (*pResult)[2]) {
+	if (max_value[1] == 0) {
+		(*pResult)[0] = rand64_bounded_multiply(rand64_function, state, max_value[0]);
+		(*pResult)[1] = 0;
+		return;
+	}
+	if (max_value[0] == UINT64_MAX && max_value[1] == UINT64_MAX) {
+		(*pResult)[0] = rand64_function(state);
+		(*pResult)[1] = rand64_function(state);
+		return;
+	}
+
+	uint64_t range[2] = {max_value[0] + 1, max_value[1] + (max_value[0] == UINT64_MAX)};
+	uint64_t t[2] = {0, 0};
+	sub_u128(&t, range);
+	mod_u128(t, range, &t);
+
+	uint64_t x[2];
+	uint64_t m[4];
+	do {
+		x[0] = rand64_function(state);
+		x[1] = rand64_function(state);
+		mul_u128(x, range, &m);
+	} while (less_u128(m, t));
+	(*pResult)[0] = m[2];
+	(*pResult)[1] = m[3];
+}
+
+static void rand128_bounded_multiply_2(rand64_func_t rand64_function, rand64_state* state, const uint64_t max_value[2], uint64_t (*pResult)[2]) {
+	if (max_value[1] == 0) {
+		(*pResult)[0] = rand64_bounded_multiply_2(rand64_function, state, max_value[0]);
+		(*pResult)[1] = 0;
+		return;
+	}
+	if (max_value[0] == UINT64_MAX && max_value[1] == UINT64_MAX) {
+		(*pResult)[0] = rand64_function(state);
+		(*pResult)[1] = rand64_function(state);
+		return;
+	}
+
+	uint64_t range[2] = {max_value[0] + 1, max_value[1] + (max_value[0] == UINT64_MAX)};
+	uint64_t x[2];
+	uint64_t m[4];
+	x[0] = rand64_function(state);
+	x[1] = rand64_function(state);
+	mul_u128(x, range, &m);
+	if (less_u128(m, range)) {
+		uint64_t t[2] = {0, 0};
+		sub_u128(&t, range);
+		if (!less_u128(t, range)) {
+			sub_u128(&t, range);
+			if (!less_u128(t, range))
+				mod_u128(t, range, &t);
+		}
+		while (less_u128(m, t)) {
+			x[0] = rand64_function(state);
+			x[1] = rand64_function(state);
+			mul_u128(x, range, &m);
+		}
+	}
+	(*pResult)[0] = m[2];
+	(*pResult)[1] = m[3];
+}
@@ -0,0 +1,273 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "Random.h"
+
+#if defined(__AVX2__)
+	#define CHACHA_AVX2 1
+	#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define CHACHA_SSE2 1
+	#include <emmintrin.h>
+#endif
+
+/* ChaCha stream cipher as a buffered RNG */
+/* Reference: https://cr.yp.to/chacha.html */
+
+// Blocks generated per refill. 8 blocks = 512 bytes, one AVX2 pass or two SSE2 passes.
+#define CHACHA_BLOCKS 8
+#define CHACHA_BUFFER_WORDS (CHACHA_BLOCKS * 16)
+
+#define CHACHA20_ROUNDS 20
+#define CHACHA8_ROUNDS 8
+
+typedef struct {
+	// Words 0-3: constant, 4-11: key, 12-13: block counter, 14-15: nonce
+	uint32_t aInput[16];
+	uint8_t DoubleRounds;
+	uint32_t Index;
+	uint32_t aBuffer[CHACHA_BUFFER_WORDS];
+} chacha_t;
+
+#define CHACHA_QUARTER_ROUND(a, b, c, d) \
+	a += b; d ^= a; d = rotl32(d, 16); \
+	c += d; b ^= c; b = rotl32(b, 12); \
+	a += b; d ^= a; d = rotl32(d, 8); \
+	c += d; b ^= c; b = rotl32(b, 7);
+
+static void chacha_block_scalar(const uint32_t aInput[16], uint8_t DoubleRounds, uint64_t Counter, uint32_t* pOut) {
+	uint32_t x[16];
+	for (uint8_t i = 0; i < 16; ++i)
+		x[i] = aInput[i];
+	x[12] = (uint32_t)Counter;
+	x[13] = (uint32_t)(Counter >> 32);
+
+	for (uint8_t i = 0; i < DoubleRounds; ++i) {
+		CHACHA_QUARTER_ROUND(x[0], x[4], x[ 8], x[12]);
+		CHACHA_QUARTER_ROUND(x[1], x[5], x[ 9], x[13]);
+		CHACHA_QUARTER_ROUND(x[2], x[6], x[10], x[14]);
+		CHACHA_QUARTER_ROUND(x[3], x[7], x[11], x[15]);
+		CHACHA_QUARTER_ROUND(x[0], x[5], x[10], x[15]);
+		CHACHA_QUARTER_ROUND(x[1], x[6], x[11], x[12]);
+		CHACHA_QUARTER_ROUND(x[2], x[7], x[ 8], x[13]);
+		CHACHA_QUARTER_ROUND(x[3], x[4], x[ 9], x[14]);
+	}
+
+	for (uint8_t i = 0; i < 16; ++i)
+		pOut[i] = x[i] + aInput[i];
+	pOut[12] = x[12] + (uint32_t)Counter;
+	pOut[13] = x[13] + (uint32_t)(Counter >> 32);
+}
+
+#if CHACHA_SSE2
+
+// 4 blocks at once, one block per lane. The state is transposed back on output.
+
+#define CHACHA_ROTL_SSE2(x, n) _mm_or_si128(_mm_slli_epi32(x, n), _mm_srli_epi32(x, 32 - (n)))
+
+#define CHACHA_QUARTER_ROUND_SSE2(a, b, c, d) \
+	a = _mm_add_epi32(a, b); d = _mm_xor_si128(d, a); d = CHACHA_ROTL_SSE2(d, 16); \
+	c = _mm_add_epi32(c, d); b = _mm_xor_si128(b, c); b = CHACHA_ROTL_SSE2(b, 12); \
+	a = _mm_add_epi32(a, b); d = _mm_xor_si128(d, a); d = CHACHA_ROTL_SSE2(d, 8); \
+	c = _mm_add_epi32(c, d); b = _mm_xor_si128(b, c); b = CHACHA_ROTL_SSE2(b, 7);
+
+static void chacha_block4_sse2(const uint32_t aInput[16], uint8_t DoubleRounds, uint64_t Counter, uint32_t* pOut) {
+	__m128i x[16];
+	__m128i Orig[16];
+	for (uint8_t i = 0; i < 16; ++i)
+		Orig[i] = _mm_set1_epi32((int)aInput[i]);
+	Orig[12] = _mm_setr_epi32(
+		(int)(uint32_t)(Counter + 0), (int)(uint32_t)(Counter + 1),
+		(int)(uint32_t)(Counter + 2), (int)(uint32_t)(Counter + 3)
+	);
+	Orig[13] = _mm_setr_epi32(
+		(int)(uint32_t)((Counter + 0) >> 32), (int)(uint32_t)((Counter + 1) >> 32),
+		(int)(uint32_t)((Counter + 2) >> 32), (int)(uint32_t)((Counter + 3) >> 32)
+	);
+	for (uint8_t i = 0; i < 16; ++i)
+		x[i] = Orig[i];
+
+	for (uint8_t i = 0; i < DoubleRounds; ++i) {
+		CHACHA_QUARTER_ROUND_SSE2(x[0], x[4], x[ 8], x[12]);
+		CHACHA_QUARTER_ROUND_SSE2(x[1], x[5], x[ 9], x[13]);
+		CHACHA_QUARTER_ROUND_SSE2(x[2], x[6], x[10], x[14]);
+		CHACHA_QUARTER_ROUND_SSE2(x[3], x[7], x[11], x[15]);
+		CHACHA_QUARTER_ROUND_SSE2(x[0], x[5], x[10], x[15]);
+		CHACHA_QUARTER_ROUND_SSE2(x[1], x[6], x[11], x[12]);
+		CHACHA_QUARTER_ROUND_SSE2(x[2], x[7], x[ 8], x[13]);
+		CHACHA_QUARTER_ROUND_SSE2(x[3], x[4], x[ 9], x[14]);
+	}
+
+	for (uint8_t i = 0; i < 16; i += 4) {
+		__m128i a = _mm_add_epi32(x[i + 0], Orig[i + 0]);
+		__m128i b = _mm_add_epi32(x[i + 1], Orig[i + 1]);
+		__m128i c = _mm_add_epi32(x[i + 2], Orig[i + 2]);
+		__m128i d = _mm_add_epi32(x[i + 3], Orig[i + 3]);
+		__m128i t0 = _mm_unpacklo_epi32(a, b);
+		__m128i t1 = _mm_unpacklo_epi32(c, d);
+		__m128i t2 = _mm_unpackhi_epi32(a, b);
+		__m128i t3 = _mm_unpackhi_epi32(c, d);
+		_mm_storeu_si128((__m128i*)(pOut + 0 * 16 + i), _mm_unpacklo_epi64(t0, t1));
+		_mm_storeu_si128((__m128i*)(pOut + 1 * 16 + i), _mm_unpackhi_epi64(t0, t1));
+		_mm_storeu_si128((__m128i*)(pOut + 2 * 16 + i), _mm_unpacklo_epi64(t2, t3));
+		_mm_storeu_si128((__m128i*)(pOut + 3 * 16 + i), _mm_unpackhi_epi64(t2, t3));
+	}
+}
+
+#elif CHACHA_AVX2
+
+// 8 blocks at once, one block per lane. Rotations by 16 and 8 are byte shuffles.
+
+#define CHACHA_ROTL_AVX2(x, n) _mm256_or_si256(_mm256_slli_epi32(x, n), _mm256_srli_epi32(x, 32 - (n)))
+
+#define CHACHA_QUARTER_ROUND_AVX2(a, b, c, d) \
+	a = _mm256_add_epi32(a, b); d = _mm256_xor_si256(d, a); d = _mm256_shuffle_epi8(d, Rot16); \
+	c = _mm256_add_epi32(c, d); b = _mm256_xor_si256(b, c); b = CHACHA_ROTL_AVX2(b, 12); \
+	a = _mm256_add_epi32(a, b); d = _mm256_xor_si256(d, a); d = _mm256_shuffle_epi8(d, Rot8); \
+	c = _mm256_add_epi32(c, d); b = _mm256_xor_si256(b, c); b = CHACHA_ROTL_AVX2(b, 7);
+
+static void chacha_block8_avx2(const uint32_t aInput[16], uint8_t DoubleRounds, uint64_t Counter, uint32_t* pOut) {
+	const __m256i Rot16 = _mm256_setr_epi8(
+		2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13,
+		2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13
+	);
+	const __m256i Rot8 = _mm256_setr_epi8(
+		3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14,
+		3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14
+	);
+
+	__m256i x[16];
+	__m256i Orig[16];
+	uint32_t aCounterLow[8];
+	uint32_t aCounterHigh[8];
+	for (uint8_t i = 0; i < 8; ++i) {
+		aCounterLow[i] = (uint32_t)(Counter + i);
+		aCounterHigh[i] = (uint32_t)((Counter + i) >> 32);
+	}
+	for (uint8_t i = 0; i < 16; ++i)
+		Orig[i] = _mm256_set1_epi32((int)aInput[i]);
+	Orig[12] = _mm256_loadu_si256((const __m256i*)aCounterLow);
+	Orig[13] = _mm256_loadu_si256((const __m256i*)aCounterHigh);
+	for (uint8_t i = 0; i < 16; ++i)
+		x[i] = Orig[i];
+
+	for (uint8_t i = 0; i < DoubleRounds; ++i) {
+		CHACHA_QUARTER_ROUND_AVX2(x[0], x[4], x[ 8], x[12]);
+		CHACHA_QUARTER_ROUND_AVX2(x[1], x[5], x[ 9], x[13]);
+		CHACHA_QUARTER_ROUND_AVX2(x[2], x[6], x[10], x[14]);
+		CHACHA_QUARTER_ROUND_AVX2(x[3], x[7], x[11], x[15]);
+		CHACHA_QUARTER_ROUND_AVX2(x[0], x[5], x[10], x[15]);
+		CHACHA_QUARTER_ROUND_AVX2(x[1], x[6], x[11], x[12]);
+		CHACHA_QUARTER_ROUND_AVX2(x[2], x[7], x[ 8], x[13]);
+		CHACHA_QUARTER_ROUND_AVX2(x[3], x[4], x[ 9], x[14]);
+	}
+
+	// Unpacks work within 128-bit halves: the low half holds blocks 0-3, the high half blocks 4-7.
+	for (uint8_t i = 0; i < 16; i += 4) {
+		__m256i a = _mm256_add_epi32(x[i + 0], Orig[i + 0]);
+		__m256i b = _mm256_add_epi32(x[i + 1], Orig[i + 1]);
+		__m256i c = _mm256_add_epi32(x[i + 2], Orig[i + 2]);
+		__m256i d = _mm256_add_epi32(x[i + 3], Orig[i + 3]);
+		__m256i t0 = _mm256_unpacklo_epi32(a, b);
+		__m256i t1 = _mm256_unpacklo_epi32(c, d);
+		__m256i t2 = _mm256_unpackhi_epi32(a, b);
+		__m256i t3 = _mm256_unpackhi_epi32(c, d);
+		__m256i r[4];
+		r[0] = _mm256_unpacklo_epi64(t0, t1);
+		r[1] = _mm256_unpackhi_epi64(t0, t1);
+		r[2] = _mm256_unpacklo_epi64(t2, t3);
+		r[3] = _mm256_unpackhi_epi64(t2, t3);
+		for (uint8_t j = 0; j < 4; ++j) {
+			_mm_storeu_si128((__m128i*)(pOut + j * 16 + i), _mm256_castsi256_si128(r[j]));
+			_mm_storeu_si128((__m128i*)(pOut + (j + 4) * 16 + i), _mm256_extracti128_si256(r[j], 1));
+		}
+	}
+}
+
+#endif
+
+static void chacha_refill(chacha_t* state) {
+	uint64_t Counter = ((uint64_t)state->aInput[13] << 32) | state->aInput[12];
+
+#if CHACHA_AVX2
+	chacha_block8_avx2(state->aInput, state->DoubleRounds, Counter, state->aBuffer);
+#elif CHACHA_SSE2
+	for (uint8_t i = 0; i < CHACHA_BLOCKS; i += 4)
+		chacha_block4_sse2(state->aInput, state->DoubleRounds, Counter + i, state->aBuffer + i * 16);
+#else
+	for (uint8_t i = 0; i < CHACHA_BLOCKS; ++i)
+		chacha_block_scalar(state->aInput, state->DoubleRounds, Counter + i, state->aBuffer + i * 16);
+#endif
+
+	Counter += CHACHA_BLOCKS;
+	state->aInput[12] = (uint32_t)Counter;
+	state->aInput[13] = (uint32_t)(Counter >> 32);
+	state->Index = 0;
+}
+
+// Key is 32 bytes. Rounds is CHACHA20_ROUNDS or CHACHA8_ROUNDS (any even number works).
+static void chacha_init(chacha_t* state, const uint8_t aKey[32], uint64_t nonce, uint8_t rounds) {
+	state->aInput[0] = 0x61707865; // "expand 32-byte k"
+	state->aInput[1] = 0x3320646e;
+	state->aInput[2] = 0x79622d32;
+	state->aInput[3] = 0x6b206574;
+	for (uint8_t i = 0; i < 8; ++i) {
+		const uint8_t* p = aKey + i * 4;
+		state->aInput[4 + i] = (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+	}
+	state->aInput[12] = 0;
+	state->aInput[13] = 0;
+	state->aInput[14] = (uint32_t)nonce;
+	state->aInput[15] = (uint32_t)(nonce >> 32);
+	state->DoubleRounds = rounds / 2;
+	state->Index = CHACHA_BUFFER_WORDS; // Generate on first use
+}
+
+static uint32_t chacha_next32(chacha_t* state) {
+	if (state->Index >= CHACHA_BUFFER_WORDS)
+		chacha_refill(state);
+	return state->aBuffer[state->Index++];
+}
+
+static uint64_t chacha_next64(chacha_t* state) {
+	if (state->Index + 2 > CHACHA_BUFFER_WORDS)
+		chacha_refill(state);
+	uint64_t Low = state->aBuffer[state->Index];
+	uint64_t High = state->aBuffer[state->Index + 1];
+	state->Index += 2;
+	return Low | (High << 32);
+}
+
+/* Wrappers */
+
+// Base must be the first member: rand64_chacha receives &Base through rand64_func_t.
+typedef struct {
+	rand64_state Base;
+	chacha_t ChaCha;
+} rand64_chacha_state;
+
+typedef struct {
+	rand32_state Base;
+	chacha_t ChaCha;
+} rand32_chacha_state;
+
+static void srand64_chacha(rand64_chacha_state* state, const uint8_t aKey[32], uint64_t nonce, uint8_t rounds) {
+	state->Base.CallCount = 0;
+	chacha_init(&state->ChaCha, aKey, nonce, rounds);
+}
+
+static uint64_t rand64_chacha(rand64_state* state) {
+	state->CallCount += 1;
+	return chacha_next64(&((rand64_chacha_state*)state)->ChaCha);
+}
+
+static void srand32_chacha(rand32_chacha_state* state, const uint8_t aKey[32], uint64_t nonce, uint8_t rounds) {
+	state->Base.CallCount = 0;
+	chacha_init(&state->ChaCha, aKey, nonce, rounds);
+}
+
+static uint32_t rand32_chacha(rand32_state* state) {
+	state->CallCount += 1;
+	return chacha_next32(&((rand32_chacha_state*)state)->ChaCha);
+}
@@ -0,0 +1,354 @@
+#pragma once
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Result files */
+
+// Two formats are read:
+//
+// + The text printed by the default benchmark (Result/*.txt): "64-bit RNG" / "32-bit RNG"
+//   section lines, then a scenario name, "Time: N us" and "Rng calls: N" per scenario.
+//   These runs use COMPARE_LEGACY_TRIAL_COUNT values per scenario and have no reference timing.
+//
+// + The output of "Main record": a "#BRB 1" line, then one "key<TAB>ns<TAB>calls" line per
+//   sample, ns and calls being per value. The key "Reference" holds the reference timing.
+//   A key can appear several times, one per repeat.
+
+#define COMPARE_LEGACY_TRIAL_COUNT 100000000.0
+#define COMPARE_MAX_SAMPLES 64
+#define COMPARE_KEY_SIZE 128
+#define COMPARE_REFERENCE_KEY "Reference"
+
+typedef struct {
+	char sKey[COMPARE_KEY_SIZE];
+	double aSample[COMPARE_MAX_SAMPLES]; // ns per value
+	size_t nSample;
+} compare_scenario_t;
+
+typedef struct {
+	compare_scenario_t* aScenario;
+	size_t nScenario;
+	size_t Capacity;
+	compare_scenario_t Reference;
+} compare_file_t;
+
+static void compare_file_free(compare_file_t* file) {
+	free(file->aScenario);
+	file->aScenario = NULL;
+	file->nScenario = 0;
+	file->Capacity = 0;
+}
+
+static compare_scenario_t* compare_find(compare_file_t* file, const char* sKey) {
+	for (size_t i = 0; i < file->nScenario; ++i)
+		if (strcmp(file->aScenario[i].sKey, sKey) == 0)
+			return &file->aScenario[i];
+	return NULL;
+}
+
+static uint8_t compare_add_sample(compare_file_t* file, const char* sKey, double value) {
+	compare_scenario_t* Scenario;
+	if (strcmp(sKey, COMPARE_REFERENCE_KEY) == 0) {
+		Scenario = &file->Reference;
+	} else {
+		Scenario = compare_find(file, sKey);
+		if (Scenario == NULL) {
+			if (file->nScenario == file->Capacity) {
+				size_t Capacity = (file->Capacity == 0) ? 64 : file->Capacity * 2;
+				compare_scenario_t* aScenario = (compare_scenario_t*)realloc(file->aScenario, Capacity * sizeof(*aScenario));
+				if (aScenario == NULL)
+					return 0;
+				file->aScenario = aScenario;
+				file->Capacity = Capacity;
+			}
+			Scenario = &file->aScenario[file->nScenario++];
+			snprintf(Scenario->sKey, sizeof(Scenario->sKey), "%s", sKey);
+			Scenario->nSample = 0;
+		}
+	}
+	if (Scenario->nSample < COMPARE_MAX_SAMPLES)
+		Scenario->aSample[Scenario->nSample++] = value;
+	return 1;
+}
+
+static void compare_trim(char* sLine) {
+	size_t Length = strlen(sLine);
+	while (Length != 0 && (sLine[Length - 1] == '\n' || sLine[Length - 1] == '\r' || sLine[Length - 1] == ' '))
+		sLine[--Length] = '\0';
+}
+
+// A positive, finite number followed by a separator or the end of the line.
+static uint8_t compare_parse_time(const char* sValue, double* pValue) {
+	char* pEnd;
+	double Value = strtod(sValue, &pEnd);
+	if (pEnd == sValue || (*pEnd != '\0' && *pEnd != '\t' && *pEnd != ' '))
+		return 0;
+	if (!isfinite(Value) || Value <= 0.0)
+		return 0;
+	*pValue = Value;
+	return 1;
+}
+
+// Returns 0 if the file cannot be opened or has a malformed time, so corrupt results
+// are never compared as 0 ns.
+static uint8_t compare_file_load(compare_file_t* file, const char* sPath) {
+	char sLine[512];
+	char sSection[64] = "";
+	char sName[COMPARE_KEY_SIZE] = "";
+	uint8_t Structured = 0;
+
+	memset(file, 0, sizeof(*file));
+	FILE* File = fopen(sPath, "r");
+	if (File == NULL)
+		return 0;
+
+	uint8_t Ok = 1;
+	for (size_t Line = 0; Ok && fgets(sLine, sizeof(sLine), File) != NULL; ++Line) {
+		compare_trim(sLine);
+		if (Line == 0 && strncmp(sLine, "#BRB", 4) == 0) {
+			Structured = 1;
+			continue;
+		}
+		if (sLine[0] == '\0' || sLine[0] == '#')
+			continue;
+
+		if (Structured) {
+			char* pTab = strchr(sLine, '\t');
+			double Value;
+			if (pTab == NULL || !compare_parse_time(pTab + 1, &Value)) {
+				Ok = 0;
+				break;
+			}
+			*pTab = '\0';
+			Ok = compare_add_sample(file, sLine, Value);
+		} else if (strcmp(sLine, "64-bit RNG") == 0 || strcmp(sLine, "32-bit RNG") == 0) {
+			snprintf(sSection, sizeof(sSection), "%s", sLine);
+		} else if (strncmp(sLine, "Time: ", 6) == 0) {
+			char sKey[COMPARE_KEY_SIZE];
+			double Value;
+			if (!compare_parse_time(sLine + 6, &Value)) {
+				Ok = 0;
+				break;
+			}
+			snprintf(sKey, sizeof(sKey), "%s / %s", sSection, sName);
+			Ok = compare_add_sample(file, sKey, Value * 1000.0 / COMPARE_LEGACY_TRIAL_COUNT);
+		} else if (strncmp(sLine, "Rng calls: ", 11) != 0) {
+			snprintf(sName, sizeof(sName), "%s", sLine);
+		}
+	}
+
+	fclose(File);
+	if (!Ok)
+		compare_file_free(file);
+	return Ok;
+}
+
+/* Statistics */
+
+static double compare_mean(const double aValue[], size_t n) {
+	double Sum = 0;
+	for (size_t i = 0; i < n; ++i)
+		Sum += aValue[i];
+	return Sum / (double)n;
+}
+
+static double compare_variance(const double aValue[], size_t n, double mean) {
+	double Sum = 0;
+	for (size_t i = 0; i < n; ++i)
+		Sum += (aValue[i] - mean) * (aValue[i] - mean);
+	return Sum / (double)(n - 1);
+}
+
+// Regularized incomplete beta function, continued fraction (modified Lentz).
+static double compare_beta_cf(double a, double b, double x) {
+	const double Tiny = 1e-300;
+	double c = 1.0;
+	double d = 1.0 - (a + b) * x / (a + 1.0);
+	if (fabs(d) < Tiny)
+		d = Tiny;
+	d = 1.0 / d;
+	double h = d;
+	for (int m = 1; m <= 300; ++m) {
+		double Num = m * (b - m) * x / ((a + 2 * m - 1) * (a + 2 * m));
+		d = 1.0 + Num * d;
+		c = 1.0 + Num / c;
+		d = 1.0 / ((fabs(d) < Tiny) ? Tiny : d);
+		c = (fabs(c) < Tiny) ? Tiny : c;
+		h *= d * c;
+
+		Num = -(a + m) * (a + b + m) * x / ((a + 2 * m) * (a + 2 * m + 1));
+		d = 1.0 + Num * d;
+		c = 1.0 + Num / c;
+		d = 1.0 / ((fabs(d) < Tiny) ? Tiny : d);
+		c = (fabs(c) < Tiny) ? Tiny : c;
+		double Delta = d * c;
+		h *= Delta;
+		if (fabs(Delta - 1.0) < 1e-12)
+			break;
+	}
+	return h;
+}
+
+static double compare_beta_inc(double a, double b, double x) {
+	if (x <= 0.0)
+		return 0.0;
+	if (x >= 1.0)
+		return 1.0;
+	double Front = exp(lgamma(a + b) - lgamma(a) - lgamma(b) + a * log(x) + b * log(1.0 - x));
+	if (x < (a + 1.0) / (a + b + 2.0))
+		return Front * compare_beta_cf(a, b, x) / a;
+	else
+		return 1.0 - Front * compare_beta_cf(b, a, 1.0 - x) / b;
+}
+
+// P(T > t) for Student's t with df degrees of freedom.
+static double compare_t_upper(double t, double df) {
+	double Tail = 0.5 * compare_beta_inc(df / 2.0, 0.5, df / (df + t * t));
+	return (t > 0) ? Tail : 1.0 - Tail;
+}
+
+/* Comparison */
+
+typedef struct {
+	double Ratio;  // Normalized current / baseline, geometric means
+	double PValue; // One-sided, H0: slowdown <= threshold. NAN without enough samples.
+	uint8_t Regression;
+} compare_verdict_t;
+
+// Samples are log(ns / norm). Welch's t-test when both sides have 2+ samples,
+// a one-sample t-test against a single baseline run, a plain threshold otherwise.
+static compare_verdict_t compare_scenario(
+	const compare_scenario_t* baseline, double baseline_norm,
+	const compare_scenario_t* current, double current_norm,
+	double threshold, double alpha
+) {
+	compare_verdict_t Verdict;
+	double aBase[COMPARE_MAX_SAMPLES];
+	double aCurrent[COMPARE_MAX_SAMPLES];
+	size_t m = baseline->nSample;
+	size_t n = current->nSample;
+	for (size_t i = 0; i < m; ++i)
+		aBase[i] = log(baseline->aSample[i] / baseline_norm);
+	for (size_t i = 0; i < n; ++i)
+		aCurrent[i] = log(current->aSample[i] / current_norm);
+
+	double MeanBase = compare_mean(aBase, m);
+	double MeanCurrent = compare_mean(aCurrent, n);
+	double Margin = log(1.0 + threshold);
+	Verdict.Ratio = exp(MeanCurrent - MeanBase);
+	Verdict.PValue = NAN;
+
+	double StdErr2 = 0.0;
+	double df = 0.0;
+	if (n >= 2 && m >= 2) {
+		double VarBase = compare_variance(aBase, m, MeanBase) / (double)m;
+		double VarCurrent = compare_variance(aCurrent, n, MeanCurrent) / (double)n;
+		StdErr2 = VarBase + VarCurrent;
+		df = StdErr2 * StdErr2 / (VarBase * VarBase / (double)(m - 1) + VarCurrent * VarCurrent / (double)(n - 1));
+	} else if (n >= 2) {
+		StdErr2 = compare_variance(aCurrent, n, MeanCurrent) / (double)n;
+		df = (double)(n - 1);
+	} else if (m >= 2) {
+		StdErr2 = compare_variance(aBase, m, MeanBase) / (double)m;
+		df = (double)(m - 1);
+	}
+
+	if (StdErr2 > 0.0) {
+		double t = (MeanCurrent - MeanBase - Margin) / sqrt(StdErr2);
+		Verdict.PValue = compare_t_upper(t, df);
+		Verdict.Regression = Verdict.PValue < alpha;
+	} else {
+		Verdict.Regression = (MeanCurrent - MeanBase) > Margin;
+	}
+	return Verdict;
+}
+
+static double compare_median(const double aValue[], size_t n) {
+	double aSorted[COMPARE_MAX_SAMPLES];
+	memcpy(aSorted, aValue, n * sizeof(double));
+	for (size_t i = 1; i < n; ++i)
+		for (size_t j = i; j > 0 && aSorted[j - 1] > aSorted[j]; --j) {
+			double Temp = aSorted[j];
+			aSorted[j] = aSorted[j - 1];
+			aSorted[j - 1] = Temp;
+		}
+	return (n % 2 == 1) ? aSorted[n / 2] : (aSorted[n / 2 - 1] + aSorted[n / 2]) / 2.0;
+}
+
+// Geometric mean of the scenario medians present in both files.
+static double compare_common_norm(compare_file_t* file, compare_file_t* other) {
+	double LogSum = 0.0;
+	size_t Count = 0;
+	for (size_t i = 0; i < file->nScenario; ++i) {
+		if (compare_find(other, file->aScenario[i].sKey) == NULL)
+			continue;
+		LogSum += log(compare_median(file->aScenario[i].aSample, file->aScenario[i].nSample));
+		Count += 1;
+	}
+	return (Count == 0) ? 1.0 : exp(LogSum / (double)Count);
+}
+
+// Number of baseline scenarios also present in current.
+static size_t compare_common_count(compare_file_t* baseline, compare_file_t* current) {
+	size_t Count = 0;
+	for (size_t i = 0; i < baseline->nScenario; ++i)
+		Count += (compare_find(current, baseline->aScenario[i].sKey) != NULL);
+	return Count;
+}
+
+// Prints one line per scenario. Returns the number of regressions, and in *pMissing
+// the number of baseline scenarios absent from current.
+// Both files are normalized by their reference timing when both have one,
+// otherwise by the geometric mean of the common scenarios (relative changes only).
+static size_t compare_files(compare_file_t* baseline, compare_file_t* current, double threshold, double alpha, size_t* pMissing) {
+	double BaseNorm;
+	double CurrentNorm;
+	if (baseline->Reference.nSample != 0 && current->Reference.nSample != 0) {
+		BaseNorm = compare_median(baseline->Reference.aSample, baseline->Reference.nSample);
+		CurrentNorm = compare_median(current->Reference.aSample, current->Reference.nSample);
+		printf("Normalized by the reference benchmark (%.3f ns -> %.3f ns)\n", BaseNorm, CurrentNorm);
+	} else {
+		BaseNorm = compare_common_norm(baseline, current);
+		CurrentNorm = compare_common_norm(current, baseline);
+		printf("No reference benchmark in both files: normalized by the geometric mean of all scenarios\n");
+	}
+	// Bonferroni correction: alpha is the chance of any false alarm over the whole file.
+	size_t Compared = compare_common_count(baseline, current);
+	double ScenarioAlpha = (Compared == 0) ? alpha : alpha / (double)Compared;
+	printf("Threshold: %.1f%%, alpha: %.3f (%.5f per scenario)\n\n", threshold * 100.0, alpha, ScenarioAlpha);
+
+	size_t Regressions = 0;
+	*pMissing = 0;
+	printf("%-56s %8s %8s %8s  %s\n", "Scenario", "Change", "p-value", "Samples", "Verdict");
+	for (size_t i = 0; i < baseline->nScenario; ++i) {
+		compare_scenario_t* Base = &baseline->aScenario[i];
+		compare_scenario_t* Current = compare_find(current, Base->sKey);
+		if (Current == NULL) {
+			printf("%-56s %8s %8s %8s  %s\n", Base->sKey, "-", "-", "-", "missing");
+			*pMissing += 1;
+			continue;
+		}
+
+		compare_verdict_t Verdict = compare_scenario(Base, BaseNorm, Current, CurrentNorm, threshold, ScenarioAlpha);
+		char sSamples[32];
+		snprintf(sSamples, sizeof(sSamples), "%zu/%zu", Base->nSample, Current->nSample);
+		printf("%-56s %+7.1f%% ", Base->sKey, (Verdict.Ratio - 1.0) * 100.0);
+		if (isnan(Verdict.PValue))
+			printf("%8s", "-");
+		else
+			printf("%8.4f", Verdict.PValue);
+		printf(" %8s  %s\n", sSamples, Verdict.Regression ? "SLOWER" : "ok");
+		Regressions += Verdict.Regression;
+	}
+	for (size_t i = 0; i < current->nScenario; ++i)
+		if (compare_find(baseline, current->aScenario[i].sKey) == NULL)
+			printf("%-56s %8s %8s %8s  %s\n", current->aScenario[i].sKey, "-", "-", "-", "new");
+
+	printf("\n%zu regression(s), %zu missing\n", Regressions, *pMissing);
+	return Regressions;
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+/* Feature macros */
+
+// Include first, before any system header: glibc fixes the feature set at its first header.
+// Headers that need these include it themselves, but only take effect when they come first.
+
+#if __linux__ && !defined(_GNU_SOURCE)
+	#define _GNU_SOURCE // pthread_setaffinity_np, vmsplice, F_SETPIPE_SZ
+#endif
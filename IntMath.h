@@ -288,3 +288,94 @@ static void mul_u64(uint64_t A, uint64_t B, uint64_t (*pResult)[2]) {
 }
 	
 #endif
+
+// Multiply two 128-bit integers to get 256-bit result
+// 128-bit integers are stored as 64-bit words, least significant first.
+
+static void mul_u128_iso(const uint64_t A[2], const uint64_t B[2], uint64_t (*pResult)[4]) {
+	uint64_t R00[2];
+	uint64_t R01[2];
+	uint64_t R10[2];
+	uint64_t R11[2];
+	mul_u64(A[0], B[0], &R00);
+	mul_u64(A[0], B[1], &R01);
+	mul_u64(A[1], B[0], &R10);
+	mul_u64(A[1], B[1], &R11);
+
+	uint64_t Col1 = R00[1] + R01[0];
+	uint8_t Carry1 = (Col1 < R01[0]);
+	Col1 += R10[0];
+	Carry1 += (Col1 < R10[0]);
+
+	uint64_t Col2 = R01[1] + R10[1];
+	uint8_t Carry2 = (Col2 < R10[1]);
+	Col2 += R11[0];
+	Carry2 += (Col2 < R11[0]);
+	Col2 += Carry1;
+	Carry2 += (Col2 < Carry1);
+
+	(*pResult)[0] = R00[0];
+	(*pResult)[1] = Col1;
+	(*pResult)[2] = Col2;
+	(*pResult)[3] = R11[1] + Carry2;
+}
+
+#if __GNUC__ && MACHINE_PTR64
+
+static void mul_u128(const uint64_t A[2], const uint64_t B[2], uint64_t (*pResult)[4]) {
+	// No partial sum can overflow: (2^64 - 1)^2 + 2 * (2^64 - 1) = 2^128 - 1
+	unsigned __int128 Low = (unsigned __int128)A[0] * B[0];
+	unsigned __int128 Mid1 = (unsigned __int128)A[0] * B[1] + (uint64_t)(Low >> 64);
+	unsigned __int128 Mid2 = (unsigned __int128)A[1] * B[0] + (uint64_t)Mid1;
+	unsigned __int128 High = (unsigned __int128)A[1] * B[1] + (uint64_t)(Mid1 >> 64) + (uint64_t)(Mid2 >> 64);
+	(*pResult)[0] = (uint64_t)Low;
+	(*pResult)[1] = (uint64_t)Mid2;
+	(*pResult)[2] = (uint64_t)High;
+	(*pResult)[3] = (uint64_t)(High >> 64);
+}
+
+#else
+
+static void mul_u128(const uint64_t A[2], const uint64_t B[2], uint64_t (*pResult)[4]) {
+	mul_u128_iso(A, B, pResult);
+}
+
+#endif
+
+// 128-bit modulo (B != 0)
+
+static void mod_u128_iso(const uint64_t A[2], const uint64_t B[2], uint64_t (*pResult)[2]) {
+	// Shift-subtract, starting from the highest set bit of A
+	uint64_t R[2] = {0, 0};
+	int16_t Top = (A[1] != 0) ? 64 + log2_u64(A[1]) : ((A[0] != 0) ? log2_u64(A[0]) : -1);
+	for (int16_t i = Top; i >= 0; --i) {
+		uint8_t Overflow = (uint8_t)(R[1] >> 63);
+		R[1] = (R[1] << 1) | (R[0] >> 63);
+		R[0] = (R[0] << 1) | ((A[i / 64] >> (i % 64)) & 1);
+		if (Overflow || R[1] > B[1] || (R[1] == B[1] && R[0] >= B[0])) {
+			uint8_t Borrow = (R[0] < B[0]);
+			R[0] -= B[0];
+			R[1] -= B[1] + Borrow;
+		}
+	}
+	(*pResult)[0] = R[0];
+	(*pResult)[1] = R[1];
+}
+
+#if __GNUC__ && MACHINE_PTR64
+
+static void mod_u128(const uint64_t A[2], const uint64_t B[2], uint64_t (*pResult)[2]) {
+	unsigned __int128 A2 = ((unsigned __int128)A[1] << 64) | A[0];
+	unsigned __int128 B2 = ((unsigned __int128)B[1] << 64) | B[0];
+	unsigned __int128 Result2 = A2 % B2;
+	(*pResult)[0] = (uint64_t)Result2;
+	(*pResult)[1] = (uint64_t)(Result2 >> 64);
+}
+
+#else
+
+static void mod_u128(const uint64_t A[2], const uint64_t B[2], uint64_t (*pResult)[2]) {
+	mod_u128_iso(A, B, pResult);
+}
+
+#endif
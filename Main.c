@@ -1,9 +1,24 @@
 
+#include "Config.h"
+
+#include <ctype.h>
 #include <inttypes.h>
+#include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "BoundedRandom64.h"
 #include "BoundedRandom32.h"
+#include "BoundedRandom128.h"
+#include "ChaCha.h"
+#include "BatchedRandom64.h"
+#include "Bernoulli64.h"
+#include "RandomRing.h"
+#include "Stream.h"
+#include "Compare.h"
+#include "Permutation.h"
+#include "Ziggurat.h"
 #include "Time.h"
 
 typedef struct {
@@ -38,7 +53,24 @@ const bounded_rand32_info_t gaBoundedRand32Info[] = {
 
 const size_t gnBoundedRand32Info = sizeof(gaBoundedRand32Info) / sizeof(*gaBoundedRand32Info);
 
-int main() {
+typedef struct {
+	void (*Function)(rand64_func_t, rand64_state*, const uint64_t[2], uint64_t (*)[2]);
+	const char* sName;
+} bounded_rand128_info_t;
+
+const bounded_rand128_info_t gaBoundedRand128Info[] = {
+	{rand128_bounded_bitmask,    "Bitmask"   },
+	{rand128_bounded_multiply,   "Multiply"  },
+	{rand128_bounded_multiply_2, "Multiply 2"},
+};
+
+const size_t gnBoundedRand128Info = sizeof(gaBoundedRand128Info) / sizeof(*gaBoundedRand128Info);
+
+static double ElapsedNs(uint64_t TimeStart, uint64_t TimeEnd) {
+	return (double)(TimeEnd - TimeStart) * 1e9 / (double)clock64_resolution();
+}
+
+static int RunDefault() {
 	const uint64_t Microsecond = clock64_resolution() / 1000000;
 	const uint64_t TrialCount = 100000000;
 	uint64_t TimeStart;
@@ -184,3 +216,1194 @@ int main() {
 	return 0;
 }
 
+/* RNG cost sweep */
+
+#define SWEEP_COST_COUNT 12
+#define SWEEP_ALGORITHM_MAX 8
+#define SWEEP_REPEAT 3
+// Smallest relative lead that counts as a crossover
+#define SWEEP_MARGIN 0.03
+
+// Extra loop iterations per RNG call for each point of the sweep.
+static const uint32_t gaSweepCost[SWEEP_COST_COUNT] = {
+	0, 1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024
+};
+
+static size_t SweepFastest(const double aTime[], size_t nAlgorithm) {
+	size_t Best = 0;
+	for (size_t i = 1; i < nAlgorithm; ++i)
+		if (aTime[i] < aTime[Best])
+			Best = i;
+	return Best;
+}
+
+static void PrintSweep(
+	const char* sTitle,
+	const char* const asName[],
+	size_t nAlgorithm,
+	const double aRngNs[SWEEP_COST_COUNT],
+	const double aaTime[SWEEP_COST_COUNT][SWEEP_ALGORITHM_MAX],
+	const double aaSpread[SWEEP_COST_COUNT][SWEEP_ALGORITHM_MAX]
+) {
+	printf("%s (ns per bounded value)\n\n", sTitle);
+
+	printf("%10s %10s", "Cost", "RNG ns");
+	for (size_t i = 0; i < nAlgorithm; ++i)
+		printf(" %14s", asName[i]);
+	printf("  Fastest\n");
+
+	for (size_t Level = 0; Level < SWEEP_COST_COUNT; ++Level) {
+		printf("%10"PRIu32" %10.2f", gaSweepCost[Level], aRngNs[Level]);
+		for (size_t i = 0; i < nAlgorithm; ++i)
+			printf(" %14.2f", aaTime[Level][i]);
+		printf("  %s\n", asName[SweepFastest(aaTime[Level], nAlgorithm)]);
+	}
+	printf("\n");
+
+	// The leader only changes when another algorithm beats it by more than the
+	// run-to-run spread of both (and at least SWEEP_MARGIN) and stays ahead at the
+	// next level, so noise around a tie does not report back-and-forth switches.
+	// The crossover is interpolated linearly between the last level the old leader
+	// held and the level it was overtaken.
+	uint8_t Found = 0;
+	size_t Leader = SweepFastest(aaTime[0], nAlgorithm);
+	for (size_t Level = 1; Level < SWEEP_COST_COUNT; ++Level) {
+		size_t New = SweepFastest(aaTime[Level], nAlgorithm);
+		if (New == Leader)
+			continue;
+
+		double Margin = SWEEP_MARGIN * aaTime[Level][Leader];
+		if (aaSpread[Level][Leader] > Margin)
+			Margin = aaSpread[Level][Leader];
+		if (aaSpread[Level][New] > Margin)
+			Margin = aaSpread[Level][New];
+		if (aaTime[Level][Leader] - aaTime[Level][New] <= Margin)
+			continue;
+		// Sustained: the old leader must not be ahead again at the next level.
+		if (Level + 1 < SWEEP_COST_COUNT && aaTime[Level + 1][Leader] < aaTime[Level + 1][New])
+			continue;
+
+		double Diff0 = aaTime[Level - 1][New] - aaTime[Level - 1][Leader];
+		double Diff1 = aaTime[Level][New] - aaTime[Level][Leader];
+		double Fraction = (Diff0 > 0.0) ? Diff0 / (Diff0 - Diff1) : 0.0;
+		double Crossover = aRngNs[Level - 1] + Fraction * (aRngNs[Level] - aRngNs[Level - 1]);
+
+		printf("Crossover: %s -> %s at ~%.2f ns per RNG call\n", asName[Leader], asName[New], Crossover);
+		Leader = New;
+		Found = 1;
+	}
+	if (!Found)
+		printf("Crossover: none, no algorithm overtakes %s by the margin\n", asName[Leader]);
+	printf("\n");
+}
+
+static void Sweep64(uint64_t TrialCount, uint64_t RangeMask, const char* sTitle) {
+	const char* asName[SWEEP_ALGORITHM_MAX];
+	double aRngNs[SWEEP_COST_COUNT];
+	double aaTime[SWEEP_COST_COUNT][SWEEP_ALGORITHM_MAX];
+	double aaSpread[SWEEP_COST_COUNT][SWEEP_ALGORITHM_MAX];
+
+	rand64_state Rng64State;
+	rand64_state Rng64State2;
+	srand64(&Rng64State, clock64());
+	srand64(&Rng64State2, clock64() + 1);
+
+	for (size_t i = 0; i < gnBoundedRand64Info; ++i)
+		asName[i] = gaBoundedRand64Info[i].sName;
+
+	for (size_t Level = 0; Level < SWEEP_COST_COUNT; ++Level) {
+		rand_set_cost(gaSweepCost[Level]);
+
+		// Calibrate the raw RNG cost. Each point keeps the fastest of SWEEP_REPEAT runs.
+		aRngNs[Level] = INFINITY;
+		for (uint8_t Repeat = 0; Repeat < SWEEP_REPEAT; ++Repeat) {
+			uint64_t TimeStart = clock64();
+			for (uint64_t ii = 0; ii < TrialCount; ++ii) {
+				volatile uint64_t Result = rand64_tunable(&Rng64State);
+			}
+			double Time = ElapsedNs(TimeStart, clock64()) / (double)TrialCount;
+			if (Time < aRngNs[Level])
+				aRngNs[Level] = Time;
+		}
+
+		for (size_t i = 0; i < gnBoundedRand64Info; ++i) {
+			bounded_rand64_info_t BoundedRand64Info = gaBoundedRand64Info[i];
+
+			double Slowest = 0.0;
+			aaTime[Level][i] = INFINITY;
+			for (uint8_t Repeat = 0; Repeat < SWEEP_REPEAT; ++Repeat) {
+				uint64_t TimeStart = clock64();
+				for (uint64_t ii = 0; ii < TrialCount; ++ii) {
+					volatile uint64_t Result = BoundedRand64Info.Function(rand64_tunable, &Rng64State, rand64(&Rng64State2) & RangeMask);
+				}
+				double Time = ElapsedNs(TimeStart, clock64()) / (double)TrialCount;
+				if (Time < aaTime[Level][i])
+					aaTime[Level][i] = Time;
+				if (Time > Slowest)
+					Slowest = Time;
+			}
+			aaSpread[Level][i] = Slowest - aaTime[Level][i];
+		}
+	}
+	rand_set_cost(0);
+
+	PrintSweep(sTitle, asName, gnBoundedRand64Info, aRngNs, aaTime, aaSpread);
+}
+
+static void Sweep32(uint64_t TrialCount, uint32_t RangeMask, const char* sTitle) {
+	const char* asName[SWEEP_ALGORITHM_MAX];
+	double aRngNs[SWEEP_COST_COUNT];
+	double aaTime[SWEEP_COST_COUNT][SWEEP_ALGORITHM_MAX];
+	double aaSpread[SWEEP_COST_COUNT][SWEEP_ALGORITHM_MAX];
+
+	rand32_state Rng32State;
+	rand32_state Rng32State2;
+	srand32_64(&Rng32State, clock64());
+	srand32_64(&Rng32State2, clock64() + 1);
+
+	for (size_t i = 0; i < gnBoundedRand32Info; ++i)
+		asName[i] = gaBoundedRand32Info[i].sName;
+
+	for (size_t Level = 0; Level < SWEEP_COST_COUNT; ++Level) {
+		rand_set_cost(gaSweepCost[Level]);
+
+		aRngNs[Level] = INFINITY;
+		for (uint8_t Repeat = 0; Repeat < SWEEP_REPEAT; ++Repeat) {
+			uint64_t TimeStart = clock64();
+			for (uint64_t ii = 0; ii < TrialCount; ++ii) {
+				volatile uint32_t Result = rand32_tunable(&Rng32State);
+			}
+			double Time = ElapsedNs(TimeStart, clock64()) / (double)TrialCount;
+			if (Time < aRngNs[Level])
+				aRngNs[Level] = Time;
+		}
+
+		for (size_t i = 0; i < gnBoundedRand32Info; ++i) {
+			bounded_rand32_info_t BoundedRand32Info = gaBoundedRand32Info[i];
+
+			double Slowest = 0.0;
+			aaTime[Level][i] = INFINITY;
+			for (uint8_t Repeat = 0; Repeat < SWEEP_REPEAT; ++Repeat) {
+				uint64_t TimeStart = clock64();
+				for (uint64_t ii = 0; ii < TrialCount; ++ii) {
+					volatile uint32_t Result = BoundedRand32Info.Function(rand32_tunable, &Rng32State, rand32(&Rng32State2) & RangeMask);
+				}
+				double Time = ElapsedNs(TimeStart, clock64()) / (double)TrialCount;
+				if (Time < aaTime[Level][i])
+					aaTime[Level][i] = Time;
+				if (Time > Slowest)
+					Slowest = Time;
+			}
+			aaSpread[Level][i] = Slowest - aaTime[Level][i];
+		}
+	}
+	rand_set_cost(0);
+
+	PrintSweep(sTitle, asName, gnBoundedRand32Info, aRngNs, aaTime, aaSpread);
+}
+
+static int RunSweep(uint64_t TrialCount) {
+	printf("\nRNG cost sweep, %"PRIu64" values per point\n\n", TrialCount);
+	Sweep64(TrialCount, UINT64_MAX, "64-bit RNG + large range");
+	Sweep64(TrialCount, 1023, "64-bit RNG + small range");
+	Sweep32(TrialCount, UINT32_MAX, "32-bit RNG + large range");
+	Sweep32(TrialCount, 1023, "32-bit RNG + small range");
+	return 0;
+}
+
+/* Generic scenario runners */
+
+// Same output format as RunDefault. The range comes from a separate xoshiro state.
+static void Bench64(const char* sScenario, rand64_func_t Rng, rand64_state* State, uint64_t RangeMask, uint64_t TrialCount) {
+	const uint64_t Microsecond = clock64_resolution() / 1000000;
+	rand64_state RangeState;
+	srand64(&RangeState, clock64());
+
+	for (size_t i = 0; i < gnBoundedRand64Info; ++i) {
+		bounded_rand64_info_t BoundedRand64Info = gaBoundedRand64Info[i];
+		State->CallCount = 0;
+
+		uint64_t TimeStart = clock64();
+		for (uint64_t ii = 0; ii < TrialCount; ++ii) {
+			volatile uint64_t Result = BoundedRand64Info.Function(Rng, State, rand64(&RangeState) & RangeMask);
+		}
+		uint64_t TimeEnd = clock64();
+
+		printf("%s + %s\n", sScenario, BoundedRand64Info.sName);
+		printf("Time: %"PRIu64" us\n", (TimeEnd - TimeStart) / Microsecond);
+		printf("Rng calls: %"PRIu64"\n\n", State->CallCount);
+	}
+}
+
+static void Bench32(const char* sScenario, rand32_func_t Rng, rand32_state* State, uint32_t RangeMask, uint64_t TrialCount) {
+	const uint64_t Microsecond = clock64_resolution() / 1000000;
+	rand32_state RangeState;
+	srand32_64(&RangeState, clock64());
+
+	for (size_t i = 0; i < gnBoundedRand32Info; ++i) {
+		bounded_rand32_info_t BoundedRand32Info = gaBoundedRand32Info[i];
+		State->CallCount = 0;
+
+		uint64_t TimeStart = clock64();
+		for (uint64_t ii = 0; ii < TrialCount; ++ii) {
+			volatile uint32_t Result = BoundedRand32Info.Function(Rng, State, rand32(&RangeState) & RangeMask);
+		}
+		uint64_t TimeEnd = clock64();
+
+		printf("%s + %s\n", sScenario, BoundedRand32Info.sName);
+		printf("Time: %"PRIu64" us\n", (TimeEnd - TimeStart) / Microsecond);
+		printf("Rng calls: %"PRIu64"\n\n", State->CallCount);
+	}
+}
+
+/* ChaCha backend */
+
+static int RunChaCha(uint64_t TrialCount) {
+	// Benchmark key only, not a secret: derived from the clock with splitmix64.
+	uint8_t aKey[32];
+	uint64_t Seed = clock64();
+	for (uint8_t i = 0; i < 32; i += 8) {
+		uint64_t Word = splitmix64_next(&Seed);
+		for (uint8_t j = 0; j < 8; ++j)
+			aKey[i + j] = (uint8_t)(Word >> (j * 8));
+	}
+
+	rand64_chacha_state ChaCha64State;
+	rand32_chacha_state ChaCha32State;
+
+	printf("\n64-bit RNG\n\n");
+
+	srand64_chacha(&ChaCha64State, aKey, 0, CHACHA20_ROUNDS);
+	Bench64("Large range + ChaCha20", rand64_chacha, &ChaCha64State.Base, UINT64_MAX, TrialCount);
+	Bench64("Small range + ChaCha20", rand64_chacha, &ChaCha64State.Base, 1023, TrialCount);
+	srand64_chacha(&ChaCha64State, aKey, 1, CHACHA8_ROUNDS);
+	Bench64("Large range + ChaCha8", rand64_chacha, &ChaCha64State.Base, UINT64_MAX, TrialCount);
+	Bench64("Small range + ChaCha8", rand64_chacha, &ChaCha64State.Base, 1023, TrialCount);
+
+	printf("\n32-bit RNG\n\n");
+
+	srand32_chacha(&ChaCha32State, aKey, 2, CHACHA20_ROUNDS);
+	Bench32("Large range + ChaCha20", rand32_chacha, &ChaCha32State.Base, UINT32_MAX, TrialCount);
+	Bench32("Small range + ChaCha20", rand32_chacha, &ChaCha32State.Base, 1023, TrialCount);
+	srand32_chacha(&ChaCha32State, aKey, 3, CHACHA8_ROUNDS);
+	Bench32("Large range + ChaCha8", rand32_chacha, &ChaCha32State.Base, UINT32_MAX, TrialCount);
+	Bench32("Small range + ChaCha8", rand32_chacha, &ChaCha32State.Base, 1023, TrialCount);
+
+	return 0;
+}
+
+/* Batched bounded random */
+
+static void PrintBatch(const char* sScenario, const char* sMethod, uint64_t TimeStart, uint64_t TimeEnd, uint64_t CallCount) {
+	const uint64_t Microsecond = clock64_resolution() / 1000000;
+	printf("%s + %s\n", sScenario, sMethod);
+	printf("Time: %"PRIu64" us\n", (TimeEnd - TimeStart) / Microsecond);
+	printf("Rng calls: %"PRIu64"\n\n", CallCount);
+}
+
+// 3D grid coordinates, TrialCount values in total.
+static void BenchBatchGrid(uint64_t TrialCount, uint64_t Side) {
+	char sScenario[64];
+	snprintf(sScenario, sizeof(sScenario), "Grid %"PRIu64"^3", Side);
+	const uint64_t aRange[3] = {Side, Side, Side};
+	uint64_t aResult[3];
+	uint64_t TimeStart;
+	uint64_t TimeEnd;
+
+	rand64_state Rng64State;
+	srand64(&Rng64State, clock64());
+
+	Rng64State.CallCount = 0;
+	TimeStart = clock64();
+	for (uint64_t ii = 0; ii < TrialCount; ii += 3) {
+		for (uint8_t j = 0; j < 3; ++j)
+			aResult[j] = rand64_bounded_multiply_2(rand64, &Rng64State, Side - 1);
+		volatile uint64_t Result = aResult[0] + aResult[1] + aResult[2];
+	}
+	TimeEnd = clock64();
+	PrintBatch(sScenario, "Multiply 2", TimeStart, TimeEnd, Rng64State.CallCount);
+
+	Rng64State.CallCount = 0;
+	TimeStart = clock64();
+	for (uint64_t ii = 0; ii < TrialCount; ii += 3) {
+		rand64_bounded_batch(rand64, &Rng64State, aRange, aResult, 3);
+		volatile uint64_t Result = aResult[0] + aResult[1] + aResult[2];
+	}
+	TimeEnd = clock64();
+	PrintBatch(sScenario, "Batched", TimeStart, TimeEnd, Rng64State.CallCount);
+}
+
+// Fisher-Yates steps n, n - 1, ..., 1, TrialCount values in total
+// (the last pass stops early when TrialCount is not a multiple of n).
+static void BenchBatchDescending(uint64_t TrialCount, size_t n) {
+	char sScenario[64];
+	snprintf(sScenario, sizeof(sScenario), "Descending from %zu", n);
+	uint64_t* aResult = malloc(n * sizeof(*aResult));
+	uint64_t TimeStart;
+	uint64_t TimeEnd;
+
+	rand64_state Rng64State;
+	srand64(&Rng64State, clock64());
+
+	Rng64State.CallCount = 0;
+	TimeStart = clock64();
+	for (uint64_t ii = 0; ii < TrialCount; ii += n) {
+		size_t Length = (TrialCount - ii < n) ? (size_t)(TrialCount - ii) : n;
+		for (size_t j = 0; j < Length; ++j)
+			aResult[j] = rand64_bounded_multiply_2(rand64, &Rng64State, n - j - 1);
+		volatile uint64_t Result = aResult[Length - 1];
+	}
+	TimeEnd = clock64();
+	PrintBatch(sScenario, "Multiply 2", TimeStart, TimeEnd, Rng64State.CallCount);
+
+	Rng64State.CallCount = 0;
+	TimeStart = clock64();
+	for (uint64_t ii = 0; ii < TrialCount; ii += n) {
+		size_t Length = (TrialCount - ii < n) ? (size_t)(TrialCount - ii) : n;
+		rand64_bounded_descending(rand64, &Rng64State, n, aResult, Length);
+		volatile uint64_t Result = aResult[Length - 1];
+	}
+	TimeEnd = clock64();
+	PrintBatch(sScenario, "Batched", TimeStart, TimeEnd, Rng64State.CallCount);
+
+	free(aResult);
+}
+
+static int RunBatch(uint64_t TrialCount) {
+	printf("\nBatched bounded random, %"PRIu64" values per scenario\n\n", TrialCount);
+	BenchBatchGrid(TrialCount, 6);
+	BenchBatchGrid(TrialCount, 1000);
+	BenchBatchGrid(TrialCount, 1000000);
+	BenchBatchDescending(TrialCount, 52);
+	BenchBatchDescending(TrialCount, 1000);
+	BenchBatchDescending(TrialCount, 1000000);
+	return 0;
+}
+
+/* Bernoulli subset selection */
+
+#define BERNOULLI_BUFFER_SIZE 4096
+
+static const double gaBernoulliP[] = {0.5, 0.25, 0.1, 1e-2, 1e-3, 1e-4, 1e-5, 1e-6};
+
+static const size_t gnBernoulliP = sizeof(gaBernoulliP) / sizeof(*gaBernoulliP);
+
+// Rate check over (0, 1), covering both paths, powers of two and p > 1/2.
+static const double gaBernoulliCheckP[] = {0.99, 0.9, 0.75, 0.6, 0.5, 0.3, 0.125, 1.0 / 64, 1e-2, 1.0 / 1024, 1e-4};
+
+static const size_t gnBernoulliCheckP = sizeof(gaBernoulliCheckP) / sizeof(*gaBernoulliCheckP);
+
+// Returns 0 when some observed rate is more than 5 standard deviations away from p.
+static uint8_t CheckBernoulli(uint64_t ItemCount) {
+	uint64_t aIndex[BERNOULLI_BUFFER_SIZE];
+	uint8_t Ok = 1;
+
+	rand64_state Rng64State;
+	srand64(&Rng64State, clock64());
+
+	printf("Rate check, %"PRIu64" items per p\n\n", ItemCount);
+
+	for (size_t i = 0; i < gnBernoulliCheckP; ++i) {
+		double P = gaBernoulliCheckP[i];
+		bernoulli64_t Sampler;
+		bernoulli64_init(&Sampler, P);
+
+		uint64_t Next = 0;
+		uint64_t Selected = 0;
+		while (Next < ItemCount)
+			Selected += bernoulli64_select(&Sampler, rand64, &Rng64State, &Next, ItemCount, aIndex, BERNOULLI_BUFFER_SIZE);
+
+		double Rate = (double)Selected / (double)ItemCount;
+		double Sigma = sqrt(P * (1.0 - P) / (double)ItemCount);
+		uint8_t Pass = fabs(Rate - P) <= 5.0 * Sigma + 1.0 / (double)ItemCount;
+		printf("p = %-10g observed %-12.6g %s\n", P, Rate, Pass ? "ok" : "FAIL");
+		if (!Pass)
+			Ok = 0;
+	}
+	printf("\n");
+
+	return Ok;
+}
+
+static int RunBernoulli(uint64_t ItemCount) {
+	const uint64_t Microsecond = clock64_resolution() / 1000000;
+	uint64_t aIndex[BERNOULLI_BUFFER_SIZE];
+	uint64_t TimeStart;
+	uint64_t TimeEnd;
+
+	rand64_state Rng64State;
+	srand64(&Rng64State, clock64());
+
+	printf("\nBernoulli selection, %"PRIu64" items per scenario\n\n", ItemCount);
+
+	for (size_t i = 0; i < gnBernoulliP; ++i) {
+		double P = gaBernoulliP[i];
+		uint64_t Selected;
+
+		// Per item: keep when a bounded value in [0, 1/p) is 0.
+		uint64_t MaxValue = (uint64_t)(1.0 / P + 0.5) - 1;
+		Selected = 0;
+		Rng64State.CallCount = 0;
+		TimeStart = clock64();
+		for (uint64_t ii = 0; ii < ItemCount; ++ii) {
+			if (rand64_bounded_bitmask(rand64, &Rng64State, MaxValue) == 0)
+				Selected += 1;
+		}
+		TimeEnd = clock64();
+
+		printf("p = %g + Bitmask per item\n", P);
+		printf("Time: %"PRIu64" us\n", (TimeEnd - TimeStart) / Microsecond);
+		printf("Rng calls: %"PRIu64"\n", Rng64State.CallCount);
+		printf("Selected: %"PRIu64"\n\n", Selected);
+
+		bernoulli64_t Sampler;
+		bernoulli64_init(&Sampler, P);
+		uint64_t Next = 0;
+		volatile uint64_t Sum = 0;
+		Selected = 0;
+		Rng64State.CallCount = 0;
+		TimeStart = clock64();
+		while (Next < ItemCount) {
+			size_t Count = bernoulli64_select(&Sampler, rand64, &Rng64State, &Next, ItemCount, aIndex, BERNOULLI_BUFFER_SIZE);
+			for (size_t j = 0; j < Count; ++j)
+				Sum += aIndex[j];
+			Selected += Count;
+		}
+		TimeEnd = clock64();
+
+		printf("p = %g + %s\n", P, (Sampler.Shift <= BERNOULLI64_DENSE_MAX_SHIFT) ? "Bitwise AND" : "Geometric skip");
+		printf("Time: %"PRIu64" us\n", (TimeEnd - TimeStart) / Microsecond);
+		printf("Rng calls: %"PRIu64"\n", Rng64State.CallCount);
+		printf("Selected: %"PRIu64"\n\n", Selected);
+	}
+
+	return CheckBernoulli(ItemCount) ? 0 : 1;
+}
+
+/* 128-bit bounded random */
+
+// RangeMask is applied to a random 128-bit max value.
+static void Bench128(const char* sScenario, const uint64_t RangeMask[2], uint64_t TrialCount) {
+	const uint64_t Microsecond = clock64_resolution() / 1000000;
+	rand64_state Rng64State;
+	rand64_state RangeState;
+	srand64(&Rng64State, clock64());
+	srand64(&RangeState, clock64() + 1);
+
+	for (size_t i = 0; i < gnBoundedRand128Info; ++i) {
+		bounded_rand128_info_t BoundedRand128Info = gaBoundedRand128Info[i];
+		uint64_t MaxValue[2];
+		uint64_t Value[2];
+		Rng64State.CallCount = 0;
+
+		uint64_t TimeStart = clock64();
+		for (uint64_t ii = 0; ii < TrialCount; ++ii) {
+			MaxValue[0] = rand64(&RangeState) & RangeMask[0];
+			MaxValue[1] = rand64(&RangeState) & RangeMask[1];
+			BoundedRand128Info.Function(rand64, &Rng64State, MaxValue, &Value);
+			volatile uint64_t Result = Value[0] ^ Value[1];
+		}
+		uint64_t TimeEnd = clock64();
+
+		printf("%s + %s\n", sScenario, BoundedRand128Info.sName);
+		printf("Time: %"PRIu64" us\n", (TimeEnd - TimeStart) / Microsecond);
+		printf("Rng calls: %"PRIu64"\n\n", Rng64State.CallCount);
+	}
+}
+
+static int RunRand128(uint64_t TrialCount) {
+	const uint64_t aLargeMask[2] = {UINT64_MAX, UINT64_MAX};
+	const uint64_t aMediumMask[2] = {UINT64_MAX, 0xFFFF};
+	const uint64_t aSmallMask[2] = {1023, 0};
+
+	printf("\n128-bit bounded random\n\n");
+	Bench128("Large range (128-bit)", aLargeMask, TrialCount);
+	Bench128("Medium range (80-bit)", aMediumMask, TrialCount);
+	Bench128("Small range", aSmallMask, TrialCount);
+	return 0;
+}
+
+/* Pre-generation ring */
+
+#define RING_CAPACITY 4096
+#define RING_MAX_VALUE 999
+// Simulated request work between two values, in loop iterations
+#define RING_WORK_ITERATIONS 64
+// Values taken between two clock reads. The work for these requests runs first, untimed.
+#define RING_TIMED_BATCH 64
+
+enum {
+	RING_INLINE_RAW,
+	RING_INLINE_BOUNDED,
+	RING_RING
+};
+
+static void SimulateWork() {
+	volatile uint64_t X = 0xAAAAAAAAAAAAAAAA;
+	for (uint32_t i = 0; i < RING_WORK_ITERATIONS; ++i)
+		X = ~X;
+}
+
+static inline uint64_t RingTake(uint8_t Source, rand_ring_t* pRing, rand64_state* pState) {
+	switch (Source) {
+	case RING_INLINE_RAW:
+		return rand64(pState);
+	case RING_INLINE_BOUNDED:
+		return rand64_bounded_multiply_2(rand64, pState, RING_MAX_VALUE);
+	default:
+		return rand_ring_get(pRing, rand64, pState);
+	}
+}
+
+// Cost of one pair of clock reads, subtracted from every timed batch.
+static double RingClockOverheadNs() {
+	double Best = INFINITY;
+	for (uint32_t i = 0; i < 10000; ++i) {
+		uint64_t TimeStart = clock64();
+		double Ns = ElapsedNs(TimeStart, clock64());
+		if (Ns < Best)
+			Best = Ns;
+	}
+	return Best;
+}
+
+// Requests are served in batches: the work of RING_TIMED_BATCH requests, then their values
+// with a clock read around them, so only the consumer side of getting a value is timed.
+static void BenchRing(const char* sScenario, uint8_t Source, rand_ring_t* pRing, rand64_state* pState, uint64_t TrialCount, double OverheadNs) {
+	double ConsumerNs = 0.0;
+	uint64_t TimeStart = clock64();
+	for (uint64_t ii = 0; ii < TrialCount; ii += RING_TIMED_BATCH) {
+		uint64_t Batch = (TrialCount - ii < RING_TIMED_BATCH) ? TrialCount - ii : RING_TIMED_BATCH;
+		for (uint64_t j = 0; j < Batch; ++j)
+			SimulateWork();
+
+		uint64_t BatchStart = clock64();
+		for (uint64_t j = 0; j < Batch; ++j) {
+			volatile uint64_t Result = RingTake(Source, pRing, pState);
+		}
+		double Ns = ElapsedNs(BatchStart, clock64()) - OverheadNs;
+		ConsumerNs += (Ns > 0.0) ? Ns : 0.0;
+	}
+	double TotalNs = ElapsedNs(TimeStart, clock64());
+
+	printf("%s\n", sScenario);
+	printf("Time: %.2f ns per request\n", TotalNs / (double)TrialCount);
+	printf("Consumer time: %.2f ns per value\n", ConsumerNs / (double)TrialCount);
+	if (pRing != NULL)
+		printf("Ring empty: %"PRIu64"\n", pRing->EmptyCount);
+	printf("\n");
+}
+
+// Core: producer thread affinity, -1 for none.
+static int RunRing(uint64_t TrialCount, int32_t Core) {
+	rand64_state Rng64State;
+	srand64(&Rng64State, clock64());
+
+	double OverheadNs = RingClockOverheadNs();
+
+	printf("\nPre-generation ring, %"PRIu64" values per scenario, range [0, %d]\n", TrialCount, RING_MAX_VALUE);
+	printf("Each request does %d iterations of work, then takes one value.\n", RING_WORK_ITERATIONS);
+	printf("Consumer time: clock reads around every %d values, minus %.2f ns clock overhead.\n\n", RING_TIMED_BATCH, OverheadNs);
+
+	BenchRing("Raw + inline", RING_INLINE_RAW, NULL, &Rng64State, TrialCount, OverheadNs);
+	BenchRing("Bounded + inline Multiply 2", RING_INLINE_BOUNDED, NULL, &Rng64State, TrialCount, OverheadNs);
+
+	rand_ring_t RawRing;
+	rand_ring_t BoundedRing;
+	rand_producer_t Producer;
+	if (!rand_ring_init(&RawRing, RING_CAPACITY, NULL, 0)) {
+		printf("Out of memory\n");
+		return 1;
+	}
+	if (!rand_ring_init(&BoundedRing, RING_CAPACITY, rand64_bounded_multiply_2, RING_MAX_VALUE)) {
+		printf("Out of memory\n");
+		rand_ring_free(&RawRing);
+		return 1;
+	}
+	rand_producer_init(&Producer, rand64, clock64() + 1, Core);
+	rand_producer_add(&Producer, &RawRing);
+	rand_producer_add(&Producer, &BoundedRing);
+	if (!rand_producer_start(&Producer)) {
+		printf("Cannot start the producer thread\n");
+		rand_ring_free(&RawRing);
+		rand_ring_free(&BoundedRing);
+		return 1;
+	}
+
+	BenchRing("Raw + ring", RING_RING, &RawRing, &Rng64State, TrialCount, OverheadNs);
+	BenchRing("Bounded + ring", RING_RING, &BoundedRing, &Rng64State, TrialCount, OverheadNs);
+
+	rand_producer_stop(&Producer);
+	printf("Producer: %"PRIu64" RNG calls, %"PRIu64" idle rounds\n", Producer.State.CallCount, Producer.IdleCount);
+	if (Core < 0)
+		printf("Producer core: any\n\n");
+	else if (Producer.Pinned)
+		printf("Producer core: %"PRId32"\n\n", Core);
+	else
+		printf("Producer core: %"PRId32" requested, pinning failed, ran unpinned\n\n", Core);
+
+	rand_ring_free(&RawRing);
+	rand_ring_free(&BoundedRing);
+	return 0;
+}
+
+/* Streaming bulk generation */
+
+// Case insensitive, '_' matches ' ' (so "multiply_2" selects "Multiply 2").
+static uint8_t MatchName(const char* sArgument, const char* sName) {
+	for (; *sArgument != '\0' && *sName != '\0'; ++sArgument, ++sName) {
+		char a = (*sArgument == '_') ? ' ' : (char)tolower((unsigned char)*sArgument);
+		char b = (char)tolower((unsigned char)*sName);
+		if (a != b)
+			return 0;
+	}
+	return *sArgument == *sName;
+}
+
+static int RunStream(int argc, char** argv) {
+	stream_source_t Source;
+	const char* sPath = NULL;
+	const char* sAlgorithm = "Multiply 2";
+	uint64_t Seed = clock64();
+	uint64_t Count = strtoull(argv[2], NULL, 10);
+
+	Source.Bits = 64;
+	Source.Raw = 1;
+	Source.MaxValue = UINT64_MAX;
+	Source.Function64 = NULL;
+	Source.Function32 = NULL;
+
+	for (int i = 3; i < argc; i += 2) {
+		if (i + 1 == argc) {
+			fprintf(stderr, "Missing value for %s\n", argv[i]);
+			return 1;
+		}
+		if (strcmp(argv[i], "--bits") == 0) {
+			if (strcmp(argv[i + 1], "32") == 0) {
+				Source.Bits = 32;
+			} else if (strcmp(argv[i + 1], "64") == 0) {
+				Source.Bits = 64;
+			} else {
+				fprintf(stderr, "--bits must be 32 or 64\n");
+				return 1;
+			}
+		} else if (strcmp(argv[i], "--max") == 0) {
+			Source.Raw = 0;
+			Source.MaxValue = strtoull(argv[i + 1], NULL, 10);
+		} else if (strcmp(argv[i], "--algo") == 0) {
+			sAlgorithm = argv[i + 1];
+		} else if (strcmp(argv[i], "--out") == 0) {
+			sPath = argv[i + 1];
+		} else if (strcmp(argv[i], "--seed") == 0) {
+			Seed = strtoull(argv[i + 1], NULL, 10);
+		} else {
+			fprintf(stderr, "Unknown option: %s\n", argv[i]);
+			return 1;
+		}
+	}
+
+	if (!Source.Raw && Source.Bits == 32 && Source.MaxValue > UINT32_MAX) {
+		fprintf(stderr, "--max does not fit in 32 bits\n");
+		return 1;
+	}
+
+	for (size_t i = 0; i < gnBoundedRand64Info; ++i)
+		if (MatchName(sAlgorithm, gaBoundedRand64Info[i].sName))
+			Source.Function64 = gaBoundedRand64Info[i].Function;
+	for (size_t i = 0; i < gnBoundedRand32Info; ++i)
+		if (MatchName(sAlgorithm, gaBoundedRand32Info[i].sName))
+			Source.Function32 = gaBoundedRand32Info[i].Function;
+	if (Source.Function64 == NULL || Source.Function32 == NULL) {
+		fprintf(stderr, "Unknown algorithm: %s\n", sAlgorithm);
+		return 1;
+	}
+
+	srand64(&Source.State64, Seed);
+	srand32_64(&Source.State32, Seed);
+	Source.State64.CallCount = 0;
+	Source.State32.CallCount = 0;
+
+	if (!stream_run(&Source, Count, sPath)) {
+		fprintf(stderr, "Write failed\n");
+		return 1;
+	}
+	return 0;
+}
+
+/* Regression tracking */
+
+// Fixed integer workload used to normalize results across machines.
+static double ReferenceNs(uint64_t Count) {
+	rand64_state State;
+	srand64(&State, 1);
+	uint64_t Divisor = 1000003;
+	uint64_t TimeStart = clock64();
+	for (uint64_t ii = 0; ii < Count; ++ii) {
+		volatile uint64_t Result = xoshiro256_next(&State) % Divisor;
+	}
+	return ElapsedNs(TimeStart, clock64()) / (double)Count;
+}
+
+static void Record64(const char* sScenario, rand64_func_t Rng, uint64_t RangeMask, uint64_t TrialCount) {
+	rand64_state Rng64State;
+	rand64_state Rng64State2;
+	srand64(&Rng64State, clock64());
+	srand64(&Rng64State2, clock64() + 1);
+
+	for (size_t i = 0; i < gnBoundedRand64Info; ++i) {
+		bounded_rand64_info_t BoundedRand64Info = gaBoundedRand64Info[i];
+		Rng64State.CallCount = 0;
+
+		uint64_t TimeStart = clock64();
+		for (uint64_t ii = 0; ii < TrialCount; ++ii) {
+			volatile uint64_t Result = BoundedRand64Info.Function(Rng, &Rng64State, rand64(&Rng64State2) & RangeMask);
+		}
+		double Ns = ElapsedNs(TimeStart, clock64()) / (double)TrialCount;
+
+		printf("64-bit RNG / %s + %s\t%.4f\t%.6f\n", sScenario, BoundedRand64Info.sName, Ns, (double)Rng64State.CallCount / (double)TrialCount);
+	}
+}
+
+static void Record32(const char* sScenario, rand32_func_t Rng, uint32_t RangeMask, uint64_t TrialCount) {
+	rand32_state Rng32State;
+	rand32_state Rng32State2;
+	srand32_64(&Rng32State, clock64());
+	srand32_64(&Rng32State2, clock64() + 1);
+
+	for (size_t i = 0; i < gnBoundedRand32Info; ++i) {
+		bounded_rand32_info_t BoundedRand32Info = gaBoundedRand32Info[i];
+		Rng32State.CallCount = 0;
+
+		uint64_t TimeStart = clock64();
+		for (uint64_t ii = 0; ii < TrialCount; ++ii) {
+			volatile uint32_t Result = BoundedRand32Info.Function(Rng, &Rng32State, rand32(&Rng32State2) & RangeMask);
+		}
+		double Ns = ElapsedNs(TimeStart, clock64()) / (double)TrialCount;
+
+		printf("32-bit RNG / %s + %s\t%.4f\t%.6f\n", sScenario, BoundedRand32Info.sName, Ns, (double)Rng32State.CallCount / (double)TrialCount);
+	}
+}
+
+// The default scenarios in the "#BRB 1" format read by compare, Repeats samples each.
+static int RunRecord(uint64_t TrialCount, uint32_t Repeats) {
+	printf("#BRB 1\n");
+	for (uint32_t Repeat = 0; Repeat < Repeats; ++Repeat) {
+		printf("%s\t%.4f\t0\n", COMPARE_REFERENCE_KEY, ReferenceNs(TrialCount));
+		Record64("Large range + fast RNG", rand64, UINT64_MAX, TrialCount);
+		Record64("Large range + slow RNG", rand64_slow, UINT64_MAX, TrialCount);
+		Record64("Small range + fast RNG", rand64, 1023, TrialCount);
+		Record64("Small range + slow RNG", rand64_slow, 1023, TrialCount);
+		Record32("Large range + fast RNG", rand32, UINT32_MAX, TrialCount);
+		Record32("Large range + slow RNG", rand32_slow, UINT32_MAX, TrialCount);
+		Record32("Small range + fast RNG", rand32, 1023, TrialCount);
+		Record32("Small range + slow RNG", rand32_slow, 1023, TrialCount);
+		fflush(stdout);
+	}
+	return 0;
+}
+
+// Exit code: 0 no regression, 1 regression, 2 unreadable input.
+static int RunCompare(int argc, char** argv) {
+	double Threshold = 0.05;
+	double Alpha = 0.05;
+	uint8_t AllowMissing = 0;
+	for (int i = 4; i < argc; ++i) {
+		if (strcmp(argv[i], "--allow-missing") == 0) {
+			AllowMissing = 1;
+		} else if (i + 1 == argc) {
+			printf("Missing value for %s\n", argv[i]);
+			return 2;
+		} else if (strcmp(argv[i], "--threshold") == 0) {
+			Threshold = strtod(argv[++i], NULL);
+		} else if (strcmp(argv[i], "--alpha") == 0) {
+			Alpha = strtod(argv[++i], NULL);
+		} else {
+			printf("Unknown option: %s\n", argv[i]);
+			return 2;
+		}
+	}
+
+	compare_file_t Baseline;
+	compare_file_t Current;
+	if (!compare_file_load(&Baseline, argv[2])) {
+		printf("Cannot read %s (missing, or a malformed or non-positive time)\n", argv[2]);
+		return 2;
+	}
+	if (!compare_file_load(&Current, argv[3])) {
+		printf("Cannot read %s (missing, or a malformed or non-positive time)\n", argv[3]);
+		compare_file_free(&Baseline);
+		return 2;
+	}
+
+	// An empty or unrelated file (e.g. a crashed run) must not pass as "no regression".
+	const char* sError = NULL;
+	if (Baseline.nScenario == 0)
+		sError = argv[2];
+	else if (Current.nScenario == 0)
+		sError = argv[3];
+	if (sError != NULL || compare_common_count(&Baseline, &Current) == 0) {
+		if (sError != NULL)
+			printf("No scenarios in %s\n", sError);
+		else
+			printf("No scenarios in common between %s and %s\n", argv[2], argv[3]);
+		compare_file_free(&Baseline);
+		compare_file_free(&Current);
+		return 2;
+	}
+
+	printf("\nBaseline: %s\nCurrent: %s\n", argv[2], argv[3]);
+	size_t Missing;
+	size_t Regressions = compare_files(&Baseline, &Current, Threshold, Alpha, &Missing);
+
+	compare_file_free(&Baseline);
+	compare_file_free(&Current);
+	return (Regressions != 0 || (Missing != 0 && !AllowMissing)) ? 1 : 0;
+}
+
+/* Pseudo-random permutation */
+
+#define PERMUTATION_CHUNK 4096
+
+// Sum and Max are over the Count outputs.
+static void PrintPermutation(const char* sScenario, uint64_t TimeStart, uint64_t TimeEnd, uint64_t Count, uint64_t MemoryBytes, uint64_t Sum, uint64_t Max, uint64_t n) {
+	const uint64_t Microsecond = clock64_resolution() / 1000000;
+	printf("%s\n", sScenario);
+	printf("Time: %"PRIu64" us\n", (TimeEnd - TimeStart) / Microsecond);
+	printf("Throughput: %.2f ns per index\n", ElapsedNs(TimeStart, TimeEnd) / (double)Count);
+	printf("Memory: %"PRIu64" bytes\n", MemoryBytes);
+	printf("Range: %s\n", (Max < n) ? "ok" : "FAILED");
+	// The sum of a full permutation of [0, n) is known, catches duplicates in most cases.
+	// A partial walk has no expected sum.
+	if (Count == n) {
+		uint64_t Expected = (n % 2 == 0) ? (n / 2) * (n - 1) : n * ((n - 1) / 2);
+		printf("Checksum: %s\n", (Sum == Expected) ? "ok" : "FAILED");
+	}
+	printf("\n");
+}
+
+// Visit the first Count indices of [0, n) in random order with the Feistel permutation.
+static void BenchPermutation(uint64_t n, uint64_t Count) {
+	char sScenario[96];
+	uint64_t aChunk[PERMUTATION_CHUNK];
+	uint64_t TimeStart;
+	uint64_t TimeEnd;
+	uint64_t Sum;
+	uint64_t Max;
+	permutation_t Perm;
+
+	TimeStart = clock64();
+	permutation_init(&Perm, n, clock64());
+	Sum = 0;
+	Max = 0;
+	for (uint64_t i = 0; i < Count; i += PERMUTATION_CHUNK) {
+		size_t Chunk = (Count - i < PERMUTATION_CHUNK) ? (size_t)(Count - i) : PERMUTATION_CHUNK;
+		permutation_fill(&Perm, i, aChunk, Chunk);
+		for (size_t j = 0; j < Chunk; ++j) {
+			Sum += aChunk[j];
+			Max = (aChunk[j] > Max) ? aChunk[j] : Max;
+		}
+	}
+	TimeEnd = clock64();
+	snprintf(sScenario, sizeof(sScenario), "n = %"PRIu64" + Feistel sequential", n);
+	PrintPermutation(sScenario, TimeStart, TimeEnd, Count, sizeof(Perm) + sizeof(aChunk), Sum, Max, n);
+
+	TimeStart = clock64();
+	Sum = 0;
+	Max = 0;
+	for (uint64_t i = 0; i < Count; ++i) {
+		uint64_t x = permutation_at(&Perm, i);
+		Sum += x;
+		Max = (x > Max) ? x : Max;
+	}
+	TimeEnd = clock64();
+	snprintf(sScenario, sizeof(sScenario), "n = %"PRIu64" + Feistel random access", n);
+	PrintPermutation(sScenario, TimeStart, TimeEnd, Count, sizeof(Perm), Sum, Max, n);
+}
+
+// n >= 1
+static int RunPermutation(uint64_t n) {
+	uint64_t TimeStart;
+	uint64_t TimeEnd;
+	uint64_t Sum;
+	uint64_t Max;
+
+	printf("\nRandom order over [0, n)\n\n");
+
+	// Fisher-Yates: materialize, shuffle, then read in order.
+	uint64_t* aArray = (uint64_t*)malloc(n * sizeof(uint64_t));
+	if (aArray == NULL) {
+		printf("n = %"PRIu64" + Fisher-Yates\nOut of memory\n\n", n);
+	} else {
+		rand64_state Rng64State;
+		srand64(&Rng64State, clock64());
+
+		TimeStart = clock64();
+		for (uint64_t i = 0; i < n; ++i)
+			aArray[i] = i;
+		for (uint64_t i = n - 1; i > 0; --i) {
+			uint64_t j = rand64_bounded_multiply_2(rand64, &Rng64State, i);
+			uint64_t Temp = aArray[i];
+			aArray[i] = aArray[j];
+			aArray[j] = Temp;
+		}
+		Sum = 0;
+		Max = 0;
+		for (uint64_t i = 0; i < n; ++i) {
+			Sum += aArray[i];
+			Max = (aArray[i] > Max) ? aArray[i] : Max;
+		}
+		TimeEnd = clock64();
+
+		char sScenario[96];
+		snprintf(sScenario, sizeof(sScenario), "n = %"PRIu64" + Fisher-Yates (Multiply 2)", n);
+		PrintPermutation(sScenario, TimeStart, TimeEnd, n, n * sizeof(uint64_t), Sum, Max, n);
+		free(aArray);
+	}
+
+	BenchPermutation(n, n);
+
+	// Index space too large to materialize: visit the first n indices only.
+	BenchPermutation(10000000000, n);
+	return 0;
+}
+
+/* Normal and exponential distributions */
+
+#define DIST_CHUNK 4096
+
+// Reference methods: Box-Muller (one pair per two uniforms) and inversion.
+
+static double gBoxMullerSpare64;
+static uint8_t gBoxMullerHasSpare64 = 0;
+
+static double BoxMuller64(rand64_func_t Rng, rand64_state* State) {
+	if (gBoxMullerHasSpare64) {
+		gBoxMullerHasSpare64 = 0;
+		return gBoxMullerSpare64;
+	}
+	double R = sqrt(-2.0 * log(1.0 - (double)(Rng(State) >> 11) * 0x1p-53));
+	double Theta = 6.283185307179586 * (double)(Rng(State) >> 11) * 0x1p-53;
+	gBoxMullerSpare64 = R * sin(Theta);
+	gBoxMullerHasSpare64 = 1;
+	return R * cos(Theta);
+}
+
+static double InverseExp64(rand64_func_t Rng, rand64_state* State) {
+	return -log(1.0 - (double)(Rng(State) >> 11) * 0x1p-53);
+}
+
+static float gBoxMullerSpare32;
+static uint8_t gBoxMullerHasSpare32 = 0;
+
+static float BoxMuller32(rand32_func_t Rng, rand32_state* State) {
+	if (gBoxMullerHasSpare32) {
+		gBoxMullerHasSpare32 = 0;
+		return gBoxMullerSpare32;
+	}
+	float R = sqrtf(-2.0f * logf(1.0f - (float)(Rng(State) >> 8) * 0x1p-24f));
+	float Theta = 6.2831853f * (float)(Rng(State) >> 8) * 0x1p-24f;
+	gBoxMullerSpare32 = R * sinf(Theta);
+	gBoxMullerHasSpare32 = 1;
+	return R * cosf(Theta);
+}
+
+static float InverseExp32(rand32_func_t Rng, rand32_state* State) {
+	return -logf(1.0f - (float)(Rng(State) >> 8) * 0x1p-24f);
+}
+
+typedef struct {
+	double (*Function)(rand64_func_t, rand64_state*);
+	void (*Fill)(rand64_func_t, rand64_state*, double[], size_t);
+	const char* sName;
+} dist64_info_t;
+
+const dist64_info_t gaDist64Info[] = {
+	{BoxMuller64,  NULL,         "Normal + Box-Muller"    },
+	{randn64,      NULL,         "Normal + Ziggurat"      },
+	{NULL,         randn64_fill, "Normal + Ziggurat fill" },
+	{InverseExp64, NULL,         "Exponential + inversion"},
+	{rande64,      NULL,         "Exponential + Ziggurat" },
+	{NULL,         rande64_fill, "Exponential + Ziggurat fill"},
+};
+
+const size_t gnDist64Info = sizeof(gaDist64Info) / sizeof(*gaDist64Info);
+
+typedef struct {
+	float (*Function)(rand32_func_t, rand32_state*);
+	void (*Fill)(rand32_func_t, rand32_state*, float[], size_t);
+	const char* sName;
+} dist32_info_t;
+
+const dist32_info_t gaDist32Info[] = {
+	{BoxMuller32,  NULL,         "Normal + Box-Muller"    },
+	{randn32,      NULL,         "Normal + Ziggurat"      },
+	{NULL,         randn32_fill, "Normal + Ziggurat fill" },
+	{InverseExp32, NULL,         "Exponential + inversion"},
+	{rande32,      NULL,         "Exponential + Ziggurat" },
+	{NULL,         rande32_fill, "Exponential + Ziggurat fill"},
+};
+
+const size_t gnDist32Info = sizeof(gaDist32Info) / sizeof(*gaDist32Info);
+
+static void PrintDist(const char* sName, uint64_t TimeStart, uint64_t TimeEnd, uint64_t SampleCount, uint64_t CallCount) {
+	const uint64_t Microsecond = clock64_resolution() / 1000000;
+	printf("%s\n", sName);
+	printf("Time: %"PRIu64" us\n", (TimeEnd - TimeStart) / Microsecond);
+	printf("Time per sample: %.2f ns\n", ElapsedNs(TimeStart, TimeEnd) / (double)SampleCount);
+	printf("Rng calls per sample: %.4f\n\n", (double)CallCount / (double)SampleCount);
+}
+
+static int RunDist(uint64_t SampleCount) {
+	static double aChunk64[DIST_CHUNK];
+	static float aChunk32[DIST_CHUNK];
+
+	double TableError = ziggurat_check();
+	if (!(TableError < ZIGGURAT_CHECK_TOLERANCE)) {
+		printf("Ziggurat table check failed, largest relative error %g\n", TableError);
+		return 1;
+	}
+	printf("Ziggurat table check: ok, largest relative error %.2g\n", TableError);
+
+	rand64_state Rng64State;
+	srand64(&Rng64State, clock64());
+
+	printf("\n64-bit RNG\n\n");
+
+	for (size_t i = 0; i < gnDist64Info; ++i) {
+		dist64_info_t Dist64Info = gaDist64Info[i];
+		Rng64State.CallCount = 0;
+
+		uint64_t TimeStart = clock64();
+		if (Dist64Info.Function != NULL) {
+			for (uint64_t ii = 0; ii < SampleCount; ++ii) {
+				volatile double Result = Dist64Info.Function(rand64, &Rng64State);
+			}
+		} else {
+			for (uint64_t ii = 0; ii < SampleCount; ii += DIST_CHUNK) {
+				size_t Chunk = (SampleCount - ii < DIST_CHUNK) ? (size_t)(SampleCount - ii) : DIST_CHUNK;
+				Dist64Info.Fill(rand64, &Rng64State, aChunk64, Chunk);
+				volatile double Result = aChunk64[Chunk - 1];
+			}
+		}
+		uint64_t TimeEnd = clock64();
+
+		PrintDist(Dist64Info.sName, TimeStart, TimeEnd, SampleCount, Rng64State.CallCount);
+	}
+
+	rand32_state Rng32State;
+	srand32_64(&Rng32State, clock64());
+
+	printf("\n32-bit RNG\n\n");
+
+	for (size_t i = 0; i < gnDist32Info; ++i) {
+		dist32_info_t Dist32Info = gaDist32Info[i];
+		Rng32State.CallCount = 0;
+
+		uint64_t TimeStart = clock64();
+		if (Dist32Info.Function != NULL) {
+			for (uint64_t ii = 0; ii < SampleCount; ++ii) {
+				volatile float Result = Dist32Info.Function(rand32, &Rng32State);
+			}
+		} else {
+			for (uint64_t ii = 0; ii < SampleCount; ii += DIST_CHUNK) {
+				size_t Chunk = (SampleCount - ii < DIST_CHUNK) ? (size_t)(SampleCount - ii) : DIST_CHUNK;
+				Dist32Info.Fill(rand32, &Rng32State, aChunk32, Chunk);
+				volatile float Result = aChunk32[Chunk - 1];
+			}
+		}
+		uint64_t TimeEnd = clock64();
+
+		PrintDist(Dist32Info.sName, TimeStart, TimeEnd, SampleCount, Rng32State.CallCount);
+	}
+
+	return 0;
+}
+
+static void PrintUsage() {
+	printf("Usage:\n");
+	printf("  Main                  Run the fixed benchmark\n");
+	printf("  Main sweep [count]    Sweep the RNG cost and report algorithm crossovers\n");
+	printf("  Main chacha [count]   Run the bounded algorithms on ChaCha20 / ChaCha8\n");
+	printf("  Main batch [count]    Compare batched bounded random against Multiply 2\n");
+	printf("  Main bernoulli [n]    Compare skip-based subset selection against per-item Bitmask\n");
+	printf("  Main rand128 [count]  Run the 128-bit bounded algorithms\n");
+	printf("  Main ring [count] [core]\n");
+	printf("                        Compare a pre-generation thread (pinned to core if given) against inline generation\n");
+	printf("  Main stream <count> [--bits 32|64] [--max N] [--algo NAME] [--out FILE] [--seed N]\n");
+	printf("                        Write count binary values (raw xoshiro without --max) to FILE or stdout\n");
+	printf("  Main record [count] [repeats]\n");
+	printf("                        Run the default scenarios repeatedly in the format read by compare\n");
+	printf("  Main compare <baseline> <current> [--threshold 0.05] [--alpha 0.05] [--allow-missing]\n");
+	printf("                        Flag slowdowns, exit code 1 on regression or missing scenario\n");
+	printf("  Main perm [n]         Compare the Feistel permutation against Fisher-Yates\n");
+	printf("  Main dist [count]     Compare Ziggurat normal / exponential against Box-Muller / inversion\n");
+}
+
+int main(int argc, char** argv) {
+	if (argc < 2)
+		return RunDefault();
+
+	if (strcmp(argv[1], "sweep") == 0) {
+		uint64_t TrialCount = (argc > 2) ? strtoull(argv[2], NULL, 10) : 10000000;
+		if (TrialCount == 0) {
+			PrintUsage();
+			return 1;
+		}
+		return RunSweep(TrialCount);
+	}
+
+	if (strcmp(argv[1], "chacha") == 0) {
+		uint64_t TrialCount = (argc > 2) ? strtoull(argv[2], NULL, 10) : 100000000;
+		return RunChaCha(TrialCount);
+	}
+
+	if (strcmp(argv[1], "batch") == 0) {
+		uint64_t TrialCount = (argc > 2) ? strtoull(argv[2], NULL, 10) : 100000000;
+		return RunBatch(TrialCount);
+	}
+
+	if (strcmp(argv[1], "bernoulli") == 0) {
+		uint64_t ItemCount = (argc > 2) ? strtoull(argv[2], NULL, 10) : 100000000;
+		if (ItemCount == 0) {
+			PrintUsage();
+			return 1;
+		}
+		return RunBernoulli(ItemCount);
+	}
+
+	if (strcmp(argv[1], "rand128") == 0) {
+		uint64_t TrialCount = (argc > 2) ? strtoull(argv[2], NULL, 10) : 100000000;
+		return RunRand128(TrialCount);
+	}
+
+	if (strcmp(argv[1], "ring") == 0) {
+		uint64_t TrialCount = (argc > 2) ? strtoull(argv[2], NULL, 10) : 100000000;
+		int32_t Core = (argc > 3) ? (int32_t)strtol(argv[3], NULL, 10) : -1;
+		return RunRing(TrialCount, Core);
+	}
+
+	if (strcmp(argv[1], "stream") == 0 && argc > 2)
+		return RunStream(argc, argv);
+
+	if (strcmp(argv[1], "record") == 0) {
+		uint64_t TrialCount = (argc > 2) ? strtoull(argv[2], NULL, 10) : 10000000;
+		uint32_t Repeats = (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 10) : 5;
+		return RunRecord(TrialCount, Repeats);
+	}
+
+	if (strcmp(argv[1], "compare") == 0 && argc > 3)
+		return RunCompare(argc, argv);
+
+	if (strcmp(argv[1], "perm") == 0) {
+		uint64_t n = (argc > 2) ? strtoull(argv[2], NULL, 10) : 10000000;
+		return RunPermutation((n == 0) ? 1 : n);
+	}
+
+	if (strcmp(argv[1], "dist") == 0) {
+		uint64_t SampleCount = (argc > 2) ? strtoull(argv[2], NULL, 10) : 100000000;
+		return RunDist(SampleCount);
+	}
+
+	PrintUsage();
+	return 1;
+}
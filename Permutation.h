@@ -0,0 +1,199 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "IntMath.h"
+#include "Random.h"
+
+#if defined(__AVX2__)
+	#define PERMUTATION_AVX2 1
+	#include <immintrin.h>
+#elif defined(__SSE4_1__)
+	#define PERMUTATION_SSE 1
+	#include <smmintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define PERMUTATION_SSE 1
+	#include <emmintrin.h>
+#endif
+
+/* Pseudo-random permutation of [0, n) in O(1) memory */
+
+// Balanced Feistel network over 2 * Half bits (the smallest even bit count >= that of n - 1),
+// so each half fits in 32 bits for any 64-bit n. Outputs >= n are fed back into the
+// network (cycle walking) until they land in [0, n); the domain is less than 4n, so this
+// takes under 4 passes on average. Not cryptographic: the round function is a 32-bit hash.
+
+#define PERMUTATION_ROUNDS 6
+// Indices computed together by permutation_fill. The rounds run on 8 (AVX2) or 4 (SSE2 /
+// SSE4.1) lanes at a time, all vectors of the block interleaved so the multiply latency
+// overlaps, and on plain loops elsewhere.
+#define PERMUTATION_BLOCK 32
+
+typedef struct {
+	uint64_t n;
+	uint8_t Half;
+	uint32_t HalfMask;
+	uint32_t aKey[PERMUTATION_ROUNDS];
+} permutation_t;
+
+// n >= 1: with n = 0 no index is ever in range and permutation_at never returns.
+static void permutation_init(permutation_t* perm, uint64_t n, uint64_t seed) {
+	uint8_t Bits = (n > 1) ? log2_u64(n - 1) + 1 : 1;
+	perm->n = n;
+	perm->Half = (Bits + 1) / 2;
+	perm->HalfMask = UINT32_MAX >> (32 - perm->Half);
+	for (uint8_t i = 0; i < PERMUTATION_ROUNDS; ++i)
+		perm->aKey[i] = (uint32_t)splitmix64_next(&seed);
+}
+
+static inline uint32_t permutation_round(uint32_t x, uint32_t key) {
+	x ^= key;
+	x *= 0x9E3779B1;
+	x ^= x >> 15;
+	x *= 0x85EBCA77;
+	x ^= x >> 13;
+	return x;
+}
+
+static inline uint64_t permutation_encrypt(const permutation_t* perm, uint64_t x) {
+	uint32_t L = (uint32_t)(x >> perm->Half);
+	uint32_t R = (uint32_t)x & perm->HalfMask;
+	for (uint8_t i = 0; i < PERMUTATION_ROUNDS; ++i) {
+		uint32_t T = R;
+		R = (L ^ permutation_round(R, perm->aKey[i])) & perm->HalfMask;
+		L = T;
+	}
+	return ((uint64_t)L << perm->Half) | R;
+}
+
+// Image of index (< n).
+static uint64_t permutation_at(const permutation_t* perm, uint64_t index) {
+	uint64_t x = permutation_encrypt(perm, index);
+	while (x >= perm->n)
+		x = permutation_encrypt(perm, x);
+	return x;
+}
+
+/* Block rounds */
+
+// Two rounds per step, updating the halves in place instead of swapping them.
+// PERMUTATION_ROUNDS is even, so L and R end up where permutation_encrypt has them.
+// The SIMD versions loop over the vectors inside each round: they are independent
+// dependency chains, so their multiplies overlap.
+
+#if PERMUTATION_AVX2
+
+static inline __m256i permutation_round_avx2(__m256i x, uint32_t key) {
+	x = _mm256_xor_si256(x, _mm256_set1_epi32((int)key));
+	x = _mm256_mullo_epi32(x, _mm256_set1_epi32((int)0x9E3779B1));
+	x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 15));
+	x = _mm256_mullo_epi32(x, _mm256_set1_epi32((int)0x85EBCA77));
+	x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 13));
+	return x;
+}
+
+static void permutation_block_rounds(const permutation_t* perm, uint32_t aL[PERMUTATION_BLOCK], uint32_t aR[PERMUTATION_BLOCK]) {
+	const __m256i HalfMask = _mm256_set1_epi32((int)perm->HalfMask);
+	__m256i aVecL[PERMUTATION_BLOCK / 8];
+	__m256i aVecR[PERMUTATION_BLOCK / 8];
+	for (size_t v = 0; v < PERMUTATION_BLOCK / 8; ++v) {
+		aVecL[v] = _mm256_loadu_si256((const __m256i*)(aL + v * 8));
+		aVecR[v] = _mm256_loadu_si256((const __m256i*)(aR + v * 8));
+	}
+	for (uint8_t i = 0; i < PERMUTATION_ROUNDS; i += 2) {
+		for (size_t v = 0; v < PERMUTATION_BLOCK / 8; ++v)
+			aVecL[v] = _mm256_and_si256(_mm256_xor_si256(aVecL[v], permutation_round_avx2(aVecR[v], perm->aKey[i])), HalfMask);
+		for (size_t v = 0; v < PERMUTATION_BLOCK / 8; ++v)
+			aVecR[v] = _mm256_and_si256(_mm256_xor_si256(aVecR[v], permutation_round_avx2(aVecL[v], perm->aKey[i + 1])), HalfMask);
+	}
+	for (size_t v = 0; v < PERMUTATION_BLOCK / 8; ++v) {
+		_mm256_storeu_si256((__m256i*)(aL + v * 8), aVecL[v]);
+		_mm256_storeu_si256((__m256i*)(aR + v * 8), aVecR[v]);
+	}
+}
+
+#elif PERMUTATION_SSE
+
+static inline __m128i permutation_mullo_sse(__m128i a, __m128i b) {
+	#if defined(__SSE4_1__)
+	return _mm_mullo_epi32(a, b);
+	#else
+	// No 32-bit low multiply before SSE4.1: even and odd lanes through _mm_mul_epu32.
+	__m128i Even = _mm_mul_epu32(a, b);
+	__m128i Odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+	return _mm_unpacklo_epi32(_mm_shuffle_epi32(Even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(Odd, _MM_SHUFFLE(0, 0, 2, 0)));
+	#endif
+}
+
+static inline __m128i permutation_round_sse(__m128i x, uint32_t key) {
+	x = _mm_xor_si128(x, _mm_set1_epi32((int)key));
+	x = permutation_mullo_sse(x, _mm_set1_epi32((int)0x9E3779B1));
+	x = _mm_xor_si128(x, _mm_srli_epi32(x, 15));
+	x = permutation_mullo_sse(x, _mm_set1_epi32((int)0x85EBCA77));
+	x = _mm_xor_si128(x, _mm_srli_epi32(x, 13));
+	return x;
+}
+
+static void permutation_block_rounds(const permutation_t* perm, uint32_t aL[PERMUTATION_BLOCK], uint32_t aR[PERMUTATION_BLOCK]) {
+	const __m128i HalfMask = _mm_set1_epi32((int)perm->HalfMask);
+	__m128i aVecL[PERMUTATION_BLOCK / 4];
+	__m128i aVecR[PERMUTATION_BLOCK / 4];
+	for (size_t v = 0; v < PERMUTATION_BLOCK / 4; ++v) {
+		aVecL[v] = _mm_loadu_si128((const __m128i*)(aL + v * 4));
+		aVecR[v] = _mm_loadu_si128((const __m128i*)(aR + v * 4));
+	}
+	for (uint8_t i = 0; i < PERMUTATION_ROUNDS; i += 2) {
+		for (size_t v = 0; v < PERMUTATION_BLOCK / 4; ++v)
+			aVecL[v] = _mm_and_si128(_mm_xor_si128(aVecL[v], permutation_round_sse(aVecR[v], perm->aKey[i])), HalfMask);
+		for (size_t v = 0; v < PERMUTATION_BLOCK / 4; ++v)
+			aVecR[v] = _mm_and_si128(_mm_xor_si128(aVecR[v], permutation_round_sse(aVecL[v], perm->aKey[i + 1])), HalfMask);
+	}
+	for (size_t v = 0; v < PERMUTATION_BLOCK / 4; ++v) {
+		_mm_storeu_si128((__m128i*)(aL + v * 4), aVecL[v]);
+		_mm_storeu_si128((__m128i*)(aR + v * 4), aVecR[v]);
+	}
+}
+
+#else
+
+static void permutation_block_rounds(const permutation_t* perm, uint32_t aL[PERMUTATION_BLOCK], uint32_t aR[PERMUTATION_BLOCK]) {
+	const uint32_t HalfMask = perm->HalfMask;
+	for (uint8_t i = 0; i < PERMUTATION_ROUNDS; i += 2) {
+		for (size_t j = 0; j < PERMUTATION_BLOCK; ++j)
+			aL[j] = (aL[j] ^ permutation_round(aR[j], perm->aKey[i])) & HalfMask;
+		for (size_t j = 0; j < PERMUTATION_BLOCK; ++j)
+			aR[j] = (aR[j] ^ permutation_round(aL[j], perm->aKey[i + 1])) & HalfMask;
+	}
+}
+
+#endif
+
+// aOut[i] = permutation_at(first + i), for first + count <= n.
+static void permutation_fill(const permutation_t* perm, uint64_t first, uint64_t aOut[], size_t count) {
+	uint32_t aL[PERMUTATION_BLOCK];
+	uint32_t aR[PERMUTATION_BLOCK];
+	const uint8_t Half = perm->Half;
+	const uint32_t HalfMask = perm->HalfMask;
+
+	while (count >= PERMUTATION_BLOCK) {
+		for (size_t j = 0; j < PERMUTATION_BLOCK; ++j) {
+			aL[j] = (uint32_t)((first + j) >> Half);
+			aR[j] = (uint32_t)(first + j) & HalfMask;
+		}
+		permutation_block_rounds(perm, aL, aR);
+		// Cycle walk the few that left [0, n)
+		for (size_t j = 0; j < PERMUTATION_BLOCK; ++j) {
+			uint64_t x = ((uint64_t)aL[j] << Half) | aR[j];
+			while (x >= perm->n)
+				x = permutation_encrypt(perm, x);
+			aOut[j] = x;
+		}
+		first += PERMUTATION_BLOCK;
+		aOut += PERMUTATION_BLOCK;
+		count -= PERMUTATION_BLOCK;
+	}
+
+	for (size_t j = 0; j < count; ++j)
+		aOut[j] = permutation_at(perm, first + j);
+}
@@ -75,6 +75,23 @@ static uint64_t rand64_slow(rand64_state* state) {
 	return rand64(state);
 }
 
+/* Tunable cost wrappers */
+
+// Extra loop iterations added to every rand64_tunable / rand32_tunable call.
+// Calibrate it against clock64() to get the cost in nanoseconds.
+static uint32_t gRandCostIterations = 0;
+
+static void rand_set_cost(uint32_t iterations) {
+	gRandCostIterations = iterations;
+}
+
+static uint64_t rand64_tunable(rand64_state* state) {
+	volatile uint64_t X = 0xAAAAAAAAAAAAAAAA;
+	for (uint32_t i = 0; i < gRandCostIterations; ++i)
+		X = ~X;
+	return rand64(state);
+}
+
 /* 32-bit RNG */
 
 typedef struct {
@@ -156,3 +173,10 @@ static uint32_t rand32_slow(rand32_state* state) {
 		X = ~X;
 	return rand32(state);
 }
+
+static uint32_t rand32_tunable(rand32_state* state) {
+	volatile uint32_t X = 0xAAAAAAAA;
+	for (uint32_t i = 0; i < gRandCostIterations; ++i)
+		X = ~X;
+	return rand32(state);
+}
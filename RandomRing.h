@@ -0,0 +1,185 @@
+#pragma once
+
+#include "Config.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "Random.h"
+#include "Thread.h"
+
+/* Pre-generated random values */
+
+// A producer thread fills single-producer / single-consumer rings, one per registered
+// range, so the consumer only pays for a load and an index update.
+//
+// Backpressure:
+// + Producer: a full ring is skipped, nothing is overwritten or dropped.
+//   When every ring is full it yields its time slice.
+// + Consumer: rand_ring_try_pop never blocks and fails on an empty ring.
+//   rand_ring_get then generates the value inline from the consumer's own state.
+
+#define RAND_RING_CACHE_LINE 64
+#define RAND_RING_MAX 8
+// Values written by the producer before publishing them
+#define RAND_RING_BATCH 64
+
+typedef uint64_t (*bounded_rand64_func_t)(rand64_func_t, rand64_state*, uint64_t);
+
+// The padding below only separates the two sides if the ring starts on a cache line.
+// Stack and static rings get this from the type; heap rings need an aligned allocation.
+#if _MSC_VER
+	#define RAND_RING_ALIGNED __declspec(align(RAND_RING_CACHE_LINE))
+#else
+	#define RAND_RING_ALIGNED __attribute__((aligned(RAND_RING_CACHE_LINE)))
+#endif
+
+typedef struct RAND_RING_ALIGNED {
+	// Producer side. Each thread keeps a copy of the other index and only reloads it
+	// when its copy says the ring is full / empty.
+	volatile size_t Head;
+	size_t TailCache;
+	uint8_t aPad0[RAND_RING_CACHE_LINE - 2 * sizeof(size_t)];
+
+	// Consumer side
+	volatile size_t Tail;
+	size_t HeadCache;
+	uint64_t EmptyCount;
+	uint8_t aPad1[RAND_RING_CACHE_LINE - 2 * sizeof(size_t) - sizeof(uint64_t)];
+
+	// Read only after rand_ring_init
+	uint64_t* aBuffer;
+	size_t Mask;
+	bounded_rand64_func_t Function; // NULL for raw words
+	uint64_t MaxValue;
+} rand_ring_t;
+
+// Capacity is rounded up to a power of two. Function is NULL for raw words.
+static uint8_t rand_ring_init(rand_ring_t* ring, size_t capacity, bounded_rand64_func_t function, uint64_t max_value) {
+	size_t Size = 1;
+	while (Size < capacity)
+		Size <<= 1;
+
+	ring->aBuffer = (uint64_t*)malloc(Size * sizeof(uint64_t));
+	if (ring->aBuffer == NULL)
+		return 0;
+	ring->Mask = Size - 1;
+	ring->Head = 0;
+	ring->TailCache = 0;
+	ring->Tail = 0;
+	ring->HeadCache = 0;
+	ring->EmptyCount = 0;
+	ring->Function = function;
+	ring->MaxValue = max_value;
+	return 1;
+}
+
+static void rand_ring_free(rand_ring_t* ring) {
+	free(ring->aBuffer);
+	ring->aBuffer = NULL;
+}
+
+static inline uint64_t rand_ring_generate(const rand_ring_t* ring, rand64_func_t rand64_function, rand64_state* state) {
+	if (ring->Function == NULL)
+		return rand64_function(state);
+	return ring->Function(rand64_function, state, ring->MaxValue);
+}
+
+// Producer side. Returns the number of values written.
+static size_t rand_ring_fill(rand_ring_t* ring, rand64_func_t rand64_function, rand64_state* state) {
+	size_t Head = ring->Head;
+	size_t Free = ring->Mask + 1 - (Head - ring->TailCache);
+	if (Free < RAND_RING_BATCH) {
+		ring->TailCache = atomic_load_acquire(&ring->Tail);
+		Free = ring->Mask + 1 - (Head - ring->TailCache);
+		if (Free == 0)
+			return 0;
+	}
+	if (Free > RAND_RING_BATCH)
+		Free = RAND_RING_BATCH;
+
+	for (size_t i = 0; i < Free; ++i)
+		ring->aBuffer[(Head + i) & ring->Mask] = rand_ring_generate(ring, rand64_function, state);
+	atomic_store_release(&ring->Head, Head + Free);
+	return Free;
+}
+
+// Consumer side
+static inline uint8_t rand_ring_try_pop(rand_ring_t* ring, uint64_t* pValue) {
+	size_t Tail = ring->Tail;
+	if (Tail == ring->HeadCache) {
+		ring->HeadCache = atomic_load_acquire(&ring->Head);
+		if (Tail == ring->HeadCache)
+			return 0;
+	}
+	*pValue = ring->aBuffer[Tail & ring->Mask];
+	atomic_store_release(&ring->Tail, Tail + 1);
+	return 1;
+}
+
+static inline uint64_t rand_ring_get(rand_ring_t* ring, rand64_func_t rand64_function, rand64_state* fallback_state) {
+	uint64_t Value;
+	if (rand_ring_try_pop(ring, &Value))
+		return Value;
+	ring->EmptyCount += 1;
+	return rand_ring_generate(ring, rand64_function, fallback_state);
+}
+
+/* Producer thread */
+
+typedef struct {
+	rand_ring_t* apRing[RAND_RING_MAX];
+	size_t nRing;
+	rand64_func_t Function;
+	rand64_state State;
+	int32_t Core; // -1: no affinity
+	uint8_t Pinned; // Set by the thread when the affinity was applied
+	volatile size_t Stop;
+	uint64_t IdleCount;
+	thread_t Thread;
+} rand_producer_t;
+
+static void rand_producer_init(rand_producer_t* producer, rand64_func_t rand64_function, uint64_t seed, int32_t core) {
+	producer->nRing = 0;
+	producer->Function = rand64_function;
+	srand64(&producer->State, seed);
+	producer->State.CallCount = 0;
+	producer->Core = core;
+	producer->Pinned = 0;
+	producer->Stop = 0;
+	producer->IdleCount = 0;
+}
+
+// Register rings before rand_producer_start.
+static uint8_t rand_producer_add(rand_producer_t* producer, rand_ring_t* ring) {
+	if (producer->nRing == RAND_RING_MAX)
+		return 0;
+	producer->apRing[producer->nRing++] = ring;
+	return 1;
+}
+
+static void rand_producer_run(void* pProducer) {
+	rand_producer_t* producer = (rand_producer_t*)pProducer;
+	if (producer->Core >= 0)
+		producer->Pinned = thread_set_core((uint32_t)producer->Core);
+
+	while (!atomic_load_acquire(&producer->Stop)) {
+		size_t Written = 0;
+		for (size_t i = 0; i < producer->nRing; ++i)
+			Written += rand_ring_fill(producer->apRing[i], producer->Function, &producer->State);
+		if (Written == 0) {
+			producer->IdleCount += 1;
+			thread_yield();
+		}
+	}
+}
+
+static uint8_t rand_producer_start(rand_producer_t* producer) {
+	return thread_start(&producer->Thread, rand_producer_run, producer);
+}
+
+static void rand_producer_stop(rand_producer_t* producer) {
+	atomic_store_release(&producer->Stop, 1);
+	thread_join(&producer->Thread);
+}
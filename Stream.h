@@ -0,0 +1,308 @@
+#pragma once
+
+#include "Config.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "BoundedRandom32.h"
+#include "BoundedRandom64.h"
+#include "Random.h"
+#include "Thread.h"
+#include "Time.h"
+
+/* Streaming bulk generation */
+
+// Binary output, native byte order. A generator thread runs ahead of the writer
+// through STREAM_BUFFER_COUNT page-aligned buffers.
+//
+// + Regular file given by name (POSIX): ftruncate + mmap, values are generated in place.
+// + Pipe (Linux): vmsplice. The pipe is resized to one buffer, so once buffer k is fully
+//   spliced, the reader has consumed buffer k - 1 and it can be refilled.
+//   Needs the GNU extensions (Config.h first), otherwise pipes use write().
+// + Anything else: write() / fwrite() from the same buffers.
+
+#define STREAM_BUFFER_BYTES ((size_t)1 << 20)
+#define STREAM_BUFFER_COUNT 4
+#define STREAM_MMAP_WINDOW ((size_t)64 << 20)
+
+#if _WIN32
+
+#include <fcntl.h>
+#include <io.h>
+
+#else
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+	#if __linux__ && defined(F_SETPIPE_SZ)
+		#define STREAM_VMSPLICE 1
+#include <sys/uio.h>
+	#endif
+
+#endif
+
+typedef struct {
+	uint8_t Bits; // 32 or 64
+	uint8_t Raw;  // Ignore Function64 / Function32 and MaxValue
+	uint64_t MaxValue;
+	uint64_t (*Function64)(rand64_func_t, rand64_state*, uint64_t);
+	uint32_t (*Function32)(rand32_func_t, rand32_state*, uint32_t);
+	rand64_state State64;
+	rand32_state State32;
+} stream_source_t;
+
+static void stream_fill(stream_source_t* source, void* pBuffer, size_t count) {
+	if (source->Bits == 64) {
+		uint64_t* aValue = (uint64_t*)pBuffer;
+		if (source->Raw) {
+			for (size_t i = 0; i < count; ++i)
+				aValue[i] = rand64(&source->State64);
+		} else {
+			for (size_t i = 0; i < count; ++i)
+				aValue[i] = source->Function64(rand64, &source->State64, source->MaxValue);
+		}
+	} else {
+		uint32_t* aValue = (uint32_t*)pBuffer;
+		if (source->Raw) {
+			for (size_t i = 0; i < count; ++i)
+				aValue[i] = rand32(&source->State32);
+		} else {
+			for (size_t i = 0; i < count; ++i)
+				aValue[i] = source->Function32(rand32, &source->State32, (uint32_t)source->MaxValue);
+		}
+	}
+}
+
+/* Buffers */
+
+static void* stream_buffer_alloc(size_t size) {
+#if _WIN32
+	return _aligned_malloc(size, 4096);
+#else
+	void* p;
+	return (posix_memalign(&p, 4096, size) == 0) ? p : NULL;
+#endif
+}
+
+static void stream_buffer_free(void* p) {
+#if _WIN32
+	_aligned_free(p);
+#else
+	free(p);
+#endif
+}
+
+typedef struct {
+	stream_source_t* pSource;
+	uint64_t TotalCount;
+	size_t BufferCount; // Values per buffer
+	uint8_t* apBuffer[STREAM_BUFFER_COUNT];
+	volatile size_t aFilled[STREAM_BUFFER_COUNT]; // Values ready, 0 = free
+} stream_pipeline_t;
+
+static void stream_generator_run(void* pPipeline) {
+	stream_pipeline_t* pipeline = (stream_pipeline_t*)pPipeline;
+	uint64_t Remaining = pipeline->TotalCount;
+	for (size_t k = 0; Remaining != 0; ++k) {
+		size_t Index = k % STREAM_BUFFER_COUNT;
+		while (atomic_load_acquire(&pipeline->aFilled[Index]) != 0)
+			thread_yield();
+
+		size_t Count = (Remaining < pipeline->BufferCount) ? (size_t)Remaining : pipeline->BufferCount;
+		stream_fill(pipeline->pSource, pipeline->apBuffer[Index], Count);
+		atomic_store_release(&pipeline->aFilled[Index], Count);
+		Remaining -= Count;
+	}
+}
+
+// Called with each filled buffer in order. Returns 0 on error.
+typedef uint8_t (*stream_sink_t)(void* pContext, const uint8_t* pData, size_t Bytes);
+
+// Lag: how many later buffers must be written before a buffer can be reused.
+static uint8_t stream_pipeline_run(stream_source_t* source, uint64_t count, stream_sink_t sink, void* pContext, size_t lag) {
+	stream_pipeline_t Pipeline;
+	size_t ValueBytes = source->Bits / 8;
+	uint8_t Ok = 1;
+
+	Pipeline.pSource = source;
+	Pipeline.TotalCount = count;
+	Pipeline.BufferCount = STREAM_BUFFER_BYTES / ValueBytes;
+	for (size_t i = 0; i < STREAM_BUFFER_COUNT; ++i) {
+		Pipeline.apBuffer[i] = (uint8_t*)stream_buffer_alloc(STREAM_BUFFER_BYTES);
+		Pipeline.aFilled[i] = 0;
+		if (Pipeline.apBuffer[i] == NULL)
+			Ok = 0;
+	}
+	if (!Ok) {
+		for (size_t i = 0; i < STREAM_BUFFER_COUNT; ++i)
+			stream_buffer_free(Pipeline.apBuffer[i]);
+		return 0;
+	}
+
+	thread_t Generator;
+	if (!thread_start(&Generator, stream_generator_run, &Pipeline)) {
+		for (size_t i = 0; i < STREAM_BUFFER_COUNT; ++i)
+			stream_buffer_free(Pipeline.apBuffer[i]);
+		return 0;
+	}
+
+	uint64_t Remaining = count;
+	for (size_t k = 0; Remaining != 0; ++k) {
+		size_t Index = k % STREAM_BUFFER_COUNT;
+		size_t Count;
+		while ((Count = atomic_load_acquire(&Pipeline.aFilled[Index])) == 0)
+			thread_yield();
+
+		// On error, keep releasing buffers so the generator can finish.
+		if (Ok)
+			Ok = sink(pContext, Pipeline.apBuffer[Index], Count * ValueBytes);
+		Remaining -= Count;
+
+		if (k >= lag)
+			atomic_store_release(&Pipeline.aFilled[(k - lag) % STREAM_BUFFER_COUNT], 0);
+	}
+
+	thread_join(&Generator);
+	for (size_t i = 0; i < STREAM_BUFFER_COUNT; ++i)
+		stream_buffer_free(Pipeline.apBuffer[i]);
+	return Ok;
+}
+
+/* Sinks */
+
+#if _WIN32
+
+static uint8_t stream_sink_fwrite(void* pContext, const uint8_t* pData, size_t Bytes) {
+	return fwrite(pData, 1, Bytes, (FILE*)pContext) == Bytes;
+}
+
+#else
+
+static uint8_t stream_sink_write(void* pContext, const uint8_t* pData, size_t Bytes) {
+	int Fd = *(int*)pContext;
+	while (Bytes != 0) {
+		ssize_t Written = write(Fd, pData, Bytes);
+		if (Written <= 0)
+			return 0;
+		pData += Written;
+		Bytes -= (size_t)Written;
+	}
+	return 1;
+}
+
+	#if STREAM_VMSPLICE
+
+static uint8_t stream_sink_vmsplice(void* pContext, const uint8_t* pData, size_t Bytes) {
+	int Fd = *(int*)pContext;
+	struct iovec Iov;
+	Iov.iov_base = (void*)pData;
+	Iov.iov_len = Bytes;
+	while (Iov.iov_len != 0) {
+		ssize_t Written = vmsplice(Fd, &Iov, 1, 0);
+		if (Written <= 0)
+			return 0;
+		Iov.iov_base = (uint8_t*)Iov.iov_base + Written;
+		Iov.iov_len -= (size_t)Written;
+	}
+	return 1;
+}
+
+	#endif
+
+// Generates straight into the file through a sliding mapping.
+static uint8_t stream_mmap(stream_source_t* source, uint64_t count, int fd) {
+	size_t ValueBytes = source->Bits / 8;
+	uint64_t TotalBytes = count * ValueBytes;
+	if (ftruncate(fd, (off_t)TotalBytes) != 0)
+		return 0;
+
+	// STREAM_MMAP_WINDOW is a multiple of the page size and of the value size.
+	for (uint64_t Offset = 0; Offset < TotalBytes; Offset += STREAM_MMAP_WINDOW) {
+		size_t Bytes = (TotalBytes - Offset < STREAM_MMAP_WINDOW) ? (size_t)(TotalBytes - Offset) : STREAM_MMAP_WINDOW;
+		void* p = mmap(NULL, Bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, (off_t)Offset);
+		if (p == MAP_FAILED)
+			return 0;
+		stream_fill(source, p, Bytes / ValueBytes);
+		munmap(p, Bytes);
+	}
+	return 1;
+}
+
+#endif
+
+/* Entry point */
+
+// Writes count values to sPath, or stdout when sPath is NULL.
+// Reports the method and the sustained rate on stderr.
+static uint8_t stream_run(stream_source_t* source, uint64_t count, const char* sPath) {
+	const char* sMethod;
+	uint8_t Ok;
+	uint64_t TimeStart = clock64();
+
+#if _WIN32
+	FILE* File;
+	if (sPath != NULL) {
+		File = fopen(sPath, "wb");
+		if (File == NULL)
+			return 0;
+	} else {
+		File = stdout;
+		_setmode(_fileno(stdout), _O_BINARY);
+	}
+	sMethod = "fwrite";
+	Ok = stream_pipeline_run(source, count, stream_sink_fwrite, File, 0);
+	if (sPath != NULL)
+		fclose(File);
+	else
+		fflush(stdout);
+#else
+	int Fd;
+	if (sPath != NULL) {
+		Fd = open(sPath, O_RDWR | O_CREAT | O_TRUNC, 0644);
+		if (Fd < 0)
+			return 0;
+	} else {
+		Fd = STDOUT_FILENO;
+	}
+
+	struct stat Stat;
+	fstat(Fd, &Stat);
+	if (sPath != NULL && S_ISREG(Stat.st_mode)) {
+		sMethod = "mmap";
+		Ok = stream_mmap(source, count, Fd);
+	} else {
+		sMethod = "write";
+		size_t Lag = 0;
+		stream_sink_t Sink = stream_sink_write;
+	#if STREAM_VMSPLICE
+		if (S_ISFIFO(Stat.st_mode)) {
+			fcntl(Fd, F_SETPIPE_SZ, (int)STREAM_BUFFER_BYTES);
+			long PipeBytes = fcntl(Fd, F_GETPIPE_SZ);
+			size_t PipeLag = (PipeBytes > 0) ? ((size_t)PipeBytes + STREAM_BUFFER_BYTES - 1) / STREAM_BUFFER_BYTES : STREAM_BUFFER_COUNT;
+			if (PipeLag < STREAM_BUFFER_COUNT - 1) {
+				sMethod = "vmsplice";
+				Sink = stream_sink_vmsplice;
+				Lag = PipeLag;
+			}
+		}
+	#endif
+		Ok = stream_pipeline_run(source, count, Sink, &Fd, Lag);
+	}
+	if (sPath != NULL)
+		close(Fd);
+#endif
+
+	double Seconds = (double)(clock64() - TimeStart) / (double)clock64_resolution();
+	double Bytes = (double)count * (source->Bits / 8);
+	fprintf(stderr, "Method: %s\n", sMethod);
+	fprintf(stderr, "Written: %.0f bytes in %.3f s\n", Bytes, Seconds);
+	fprintf(stderr, "Rate: %.3f GB/s\n", Bytes / Seconds / 1e9);
+	return Ok;
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "Config.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Threads */
+
+#if _WIN32
+
+#include <Windows.h>
+
+typedef struct {
+	void (*Function)(void*);
+	void* pArgument;
+	HANDLE Handle;
+} thread_t;
+
+static DWORD WINAPI thread_entry(LPVOID pThread) {
+	thread_t* Thread = (thread_t*)pThread;
+	Thread->Function(Thread->pArgument);
+	return 0;
+}
+
+static uint8_t thread_start(thread_t* Thread, void (*Function)(void*), void* pArgument) {
+	Thread->Function = Function;
+	Thread->pArgument = pArgument;
+	Thread->Handle = CreateThread(NULL, 0, thread_entry, Thread, 0, NULL);
+	return Thread->Handle != NULL;
+}
+
+static void thread_join(thread_t* Thread) {
+	WaitForSingleObject(Thread->Handle, INFINITE);
+	CloseHandle(Thread->Handle);
+}
+
+static void thread_yield() {
+	SwitchToThread();
+}
+
+// Pin the calling thread to a core. Returns 0 if the core does not exist or is not allowed.
+static uint8_t thread_set_core(uint32_t Core) {
+	if (Core >= sizeof(DWORD_PTR) * 8)
+		return 0;
+	return SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << Core) != 0;
+}
+
+#else
+
+#include <pthread.h>
+#include <sched.h>
+
+	#if __linux__ && !defined(CPU_SET)
+		#warning "CPU affinity unavailable: include Config.h before any system header"
+	#endif
+
+typedef struct {
+	void (*Function)(void*);
+	void* pArgument;
+	pthread_t Handle;
+} thread_t;
+
+static void* thread_entry(void* pThread) {
+	thread_t* Thread = (thread_t*)pThread;
+	Thread->Function(Thread->pArgument);
+	return NULL;
+}
+
+static uint8_t thread_start(thread_t* Thread, void (*Function)(void*), void* pArgument) {
+	Thread->Function = Function;
+	Thread->pArgument = pArgument;
+	return pthread_create(&Thread->Handle, NULL, thread_entry, Thread) == 0;
+}
+
+static void thread_join(thread_t* Thread) {
+	pthread_join(Thread->Handle, NULL);
+}
+
+static void thread_yield() {
+	sched_yield();
+}
+
+// Pin the calling thread to a core. Returns 0 if the core does not exist or is not allowed,
+// and always on platforms without affinity support.
+static uint8_t thread_set_core(uint32_t Core) {
+#if defined(__linux__) && defined(CPU_SET)
+	if (Core >= CPU_SETSIZE)
+		return 0;
+	cpu_set_t Set;
+	CPU_ZERO(&Set);
+	CPU_SET(Core, &Set);
+	return pthread_setaffinity_np(pthread_self(), sizeof(Set), &Set) == 0;
+#else
+	(void)Core;
+	return 0;
+#endif
+}
+
+#endif
+
+/* Acquire / release on a size_t shared by two threads */
+
+#if _MSC_VER
+
+	#if defined(_M_ARM) || defined(_M_ARM64)
+		#define THREAD_BARRIER() __dmb(_ARM_BARRIER_ISH)
+	#else
+		#define THREAD_BARRIER() _ReadWriteBarrier()
+	#endif
+
+static size_t atomic_load_acquire(volatile size_t* p) {
+	size_t Value = *p;
+	THREAD_BARRIER();
+	return Value;
+}
+
+static void atomic_store_release(volatile size_t* p, size_t Value) {
+	THREAD_BARRIER();
+	*p = Value;
+}
+
+#else
+
+static size_t atomic_load_acquire(volatile size_t* p) {
+	return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+static void atomic_store_release(volatile size_t* p, size_t Value) {
+	__atomic_store_n(p, Value, __ATOMIC_RELEASE);
+}
+
+#endif
@@ -23,6 +23,18 @@ static uint64_t clock64_resolution() {
 	return ClockRes;
 }
 
-// No POSIX implementation yet.
+#else
+
+#include <time.h>
+
+static uint64_t clock64() {
+	struct timespec TimeStruct;
+	clock_gettime(CLOCK_MONOTONIC, &TimeStruct);
+	return (uint64_t)TimeStruct.tv_sec * 1000000000 + (uint64_t)TimeStruct.tv_nsec;
+}
+
+static uint64_t clock64_resolution() {
+	return 1000000000;
+}
 
 #endif
@@ -0,0 +1,819 @@
+#pragma once
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Random.h"
+
+/* Ziggurat normal and exponential distributions */
+/* Reference: Marsaglia & Tsang, "The Ziggurat Method for Generating Random Variables" */
+/* Reference: Doornik, "An Improved Ziggurat Method to Generate Normal Random Samples" */
+
+// 256 layers of equal area V under f(x) = exp(-x^2 / 2) (normal) or exp(-x) (exponential).
+// X[1] = R is the start of the tail, X[0] = V / f(R) is the width the base layer would have
+// as a rectangle, X[i] = f^-1(V / X[i - 1] + f(X[i - 1])) and X[256] = 0. F[i] = f(X[i]).
+//
+// One draw gives the layer i (low 8 bits) and an integer position m in it (high bits).
+// The tables hold, per layer, the Marsaglia-Tsang integer ratio K[i] = ceil(2^b X[i + 1] / X[i])
+// and the scale W[i] = X[i] 2^-b, b being the width of m. m < K[i] means the sample lies in the
+// inner rectangle of the layer and is accepted right away: one RNG call, one table lookup and one
+// integer compare, and only then one multiply by W[i]. This covers ~99% of the samples.
+// K[255] = 0 since X[256] = 0, the top layer always goes through the wedge test.
+//
+// X is not stored, it is W[i] 2^b exactly. ziggurat_check() rebuilds the tables from the
+// equal-area definition above, see there.
+
+#define ZIGGURAT_LAYERS 256
+
+#define ZIGGURAT_NORMAL_R 3.6541528853610088
+#define ZIGGURAT_EXP_R 7.69711747013104972
+
+// Width of m: 52 bits + sign (normal) or 53 bits (exponential) in 64-bit, 23 + sign or 24 in 32-bit
+#define ZIGGURAT_NORMAL_BITS 52
+#define ZIGGURAT_EXP_BITS 53
+#define ZIGGURAT_NORMAL_BITS32 23
+#define ZIGGURAT_EXP_BITS32 24
+
+static const uint64_t gaZigNormalK[ZIGGURAT_LAYERS] = {
+	0xEF33D8025BC3A, 0xF1A5A4B331A0B, 0xF66C5F7F02F1A, 0xF89FA48A41D49,
+	0xF9E971E014511, 0xFAC40582A2806, 0xFB606C40053D6, 0xFBD6581C0B7E7,
+	0xFC32B2F1E22A2, 0xFC7D26ECD2CDE, 0xFCBA8D85E1171, 0xFCEE204761F62,
+	0xFD1A1A7B4C772, 0xFD40149E2EFDB, 0xFD613ADBD64D6, 0xFD7E6EF48CED1,
+	0xFD985E1B2BA43, 0xFDAF8F82E0252, 0xFDC46E529BEE3, 0xFDD7509C63BCE,
+	0xFDE87C57EFE7C, 0xFDF82B02B717D, 0xFE068C4EE6783, 0xFE13C827882E9,
+	0xFE2000399552C, 0xFE2B5122FE4D3, 0xFE35D35EEB172, 0xFE3F9BFFD1E0D,
+	0xFE48BD436F42E, 0xFE51470977257, 0xFE5947338F719, 0xFE60C9F383055,
+	0xFE67DA0B6ABB0, 0xFE6E8102AA1D9, 0xFE74C751F6A7D, 0xFE7AB48823397,
+	0xFE804F690A917, 0xFE859E07AB1C2, 0xFE8AA5DC4E8BE, 0xFE8F6BD76C5AE,
+	0xFE93F471D4700, 0xFE9843BA9477B, 0xFE9C5D62F5612, 0xFEA044C8DD9CF,
+	0xFEA3FCFFD73BD, 0xFEA788D8EE2FE, 0xFEAAEAE99222E, 0xFEAE2591A02C0,
+	0xFEB13B00B2D23, 0xFEB42D3AD1F76, 0xFEB6FE1C98519, 0xFEB9AF5EE0CB4,
+	0xFEBC429A0B668, 0xFEBEB948E6FA8, 0xFEC114CB4B30B, 0xFEC356686C938,
+	0xFEC57F50F31D4, 0xFEC790A0DA94F, 0xFEC98B6123096, 0xFECB708956E89,
+	0xFECD4100EB78D, 0xFECEFDA07FE09, 0xFED0A732FE618, 0xFED23E76A2FAD,
+	0xFED3C41DEA3F7, 0xFED538D06ADD3, 0xFED69D2B9BFFE, 0xFED7F1C38A80A,
+	0xFED937237E960, 0xFEDA6DCE9389C, 0xFEDB964042CC6, 0xFEDCB0ECE39A5,
+	0xFEDDBE422044F, 0xFEDEBEA76213E, 0xFEDFB27E3499D, 0xFEE09A22A1418,
+	0xFEE175EB83C2A, 0xFEE2462AD81D5, 0xFEE30B2E02AA7, 0xFEE3C53E12C1F,
+	0xFEE474A00069E, 0xFEE51994E5785, 0xFEE5B45A32857, 0xFEE64529E004D,
+	0xFEE6CC3A9BD2C, 0xFEE749BFF37CC, 0xFEE7BDEA7B854, 0xFEE828E7F3DC9,
+	0xFEE88AE369C45, 0xFEE8E405574E0, 0xFEE93473C0A04, 0xFEE97C524F2AE,
+	0xFEE9BBC26AEF8, 0xFEE9F2E351FED, 0xFEEA21D22E4A2, 0xFEEA48AA29E4A,
+	0xFEEA678481CEC, 0xFEEA7E789761B, 0xFEEA8D9C00724, 0xFEEA9502963D5,
+	0xFEEA94BE83301, 0xFEEA8CE04F9CF, 0xFEEA7D76ED6BE, 0xFEEA668FC2D34,
+	0xFEEA4836B426D, 0xFEEA22762CC70, 0xFEE9F557273B5, 0xFEE9C0E13481B,
+	0xFEE9851A829AA, 0xFEE94207E2599, 0xFEE8F7ACCC80F, 0xFEE8A60B662FF,
+	0xFEE84D2484A6F, 0xFEE7ECF7B0674, 0xFEE7858327B3C, 0xFEE716C3E0734,
+	0xFEE6A0B5897A9, 0xFEE623528B3E6, 0xFEE59E9407EF8, 0xFEE51271DB03C,
+	0xFEE47EE2982A9, 0xFEE3E3DB89AF1, 0xFEE34150AE46F, 0xFEE29734B64D6,
+	0xFEE1E57900690, 0xFEE12C0D959B6, 0xFEE06AE124B73, 0xFEDFA1E0FD3C1,
+	0xFEDED0F90992C, 0xFEDDF813C8A7D, 0xFEDD171A46DFC, 0xFEDC2DF4165FB,
+	0xFEDB3C8746A5A, 0xFEDA42B85B6A9, 0xFED9406A42C6D, 0xFED8357E4A924,
+	0xFED721D414F8A, 0xFED605498C37D, 0xFED4DFBAD580C, 0xFED3B10242EE9,
+	0xFED278F84489E, 0xFED13773584C2, 0xFECFEC47F914F, 0xFECE97488C84A,
+	0xFECD38454FAAA, 0xFECBCF0C42791, 0xFECA5B6911EA2, 0xFEC8DD2500C43,
+	0xFEC75406CEE81, 0xFEC5BFD29F121, 0xFEC42049DAF5C, 0xFEC2752B1599B,
+	0xFEC0BE31EBD6D, 0xFEBEFB16E2DC0, 0xFEBD2B8F4494F, 0xFEBB4F4CF9CF9,
+	0xFEB965FE61F8E, 0xFEB76F4E28471, 0xFEB56AE316229, 0xFEB3585FE29BD,
+	0xFEB13762FEB82, 0xFEAF07865E5A9, 0xFEACC85F3D889, 0xFEAA797DE1C56,
+	0xFEA81A6D5737D, 0xFEA5AAB32948D, 0xFEA329CF16601, 0xFEA0973ABE5D4,
+	0xFE9DF2694B62B, 0xFE9B3AC7147B8, 0xFE986FB9399EF, 0xFE95909D38834,
+	0xFE929CC879A62, 0xFE8F9387D4E36, 0xFE8C741F0CDF8, 0xFE893DC84079C,
+	0xFE85EFB35166E, 0xFE8289053EFB9, 0xFE7F08D77416B, 0xFE7B6E3706FC4,
+	0xFE77B823E9D56, 0xFE73E5900A618, 0xFE6FF55E5F402, 0xFE6BE661E10B5,
+	0xFE67B75C6D47C, 0xFE6366FD90F74, 0xFE5EF3E13857E, 0xFE5A5C8E410FF,
+	0xFE559F74EBB5D, 0xFE50BAED29402, 0xFE4BAD34C0830, 0xFE46746D475FF,
+	0xFE410E99EAC3F, 0xFE3B799CFFEE1, 0xFE35B33558BF7, 0xFE2FB8FB54028,
+	0xFE29885DA1A27, 0xFE231E9DB1B33, 0xFE1C78CBC3E15, 0xFE1593C28B6BB,
+	0xFE0E6C225A0B9, 0xFE06FE4BC2343, 0xFDFF46599EB81, 0xFDF7401A6B25F,
+	0xFDEEE708D4F6D, 0xFDE6364369D6F, 0xFDDD288342D87, 0xFDD3B8118707F,
+	0xFDC9DEBB99848, 0xFDBF95C5BFA84, 0xFDB4D5DC02BB9, 0xFDA9970105C09,
+	0xFD9DD07A7AB32, 0xFD9178BAD29CC, 0xFD848547B0606, 0xFD76EA9C8E52B,
+	0xFD689C08E96BD, 0xFD598B8920BF9, 0xFD49A9990B0F2, 0xFD38E4FF0C565,
+	0xFD272A8E2F060, 0xFD1464DD6C0BB, 0xFD007BF1DC4C7, 0xFCEB54D8FE7E8,
+	0xFCD4D12F834C6, 0xFCBCCE9021DC7, 0xFCA325E4BD8D4, 0xFC87AA928908B,
+	0xFC6A2977AE7A3, 0xFC4A67AE254C3, 0xFC28210379AAB, 0xFC03060FF6416,
+	0xFBDAB9D0402F5, 0xFBAECE9A1DB42, 0xFB7EC2366F3BD, 0xFB49F8D5368F9,
+	0xFB0FB6718AC00, 0xFACF160D3465A, 0xFA86FDE5B3BBF, 0xFA360F581E82F,
+	0xF9DA907DBE051, 0xF9724C74DB927, 0xF8FA657830A7D, 0xF86F10C6337D8,
+	0xF7CB2EC281EC4, 0xF707A75536927, 0xF61A5E41B6BE4, 0xF4F469560DF96,
+	0xF37ED61FF712F, 0xF19470AF9CC81, 0xEEF4B817E221C, 0xEB255E9D2FA41,
+	0xE51F67EC049B5, 0xDA354FABA4236, 0xC08BE98F2ACAA, 0x0000000000000,
+};
+
+static const double gaZigNormalW[ZIGGURAT_LAYERS] = {
+	8.68362706082834733e-16, 8.11384933765648419e-16, 7.65893637080453540e-16, 7.37242430179733360e-16,
+	7.15999493482894844e-16, 6.98971833638573063e-16, 6.84680341756223730e-16, 6.72315046250345868e-16,
+	6.61382788509544647e-16, 6.51560331734269798e-16, 6.42623965954569178e-16, 6.34412240712508024e-16,
+	6.26804696329880145e-16, 6.19708989457909035e-16, 6.13052720872269709e-16, 6.06778040933081865e-16,
+	6.00837969626923507e-16, 5.95193814963872949e-16, 5.89813317647514532e-16, 5.84669289345268643e-16,
+	5.79738594572176361e-16, 5.75001376891702871e-16, 5.70440462128848706e-16, 5.66040892007948662e-16,
+	5.61789555355244758e-16, 5.57674893292357486e-16, 5.53686661246484283e-16, 5.49815735088975037e-16,
+	5.46053951907168610e-16, 5.42393978219858747e-16, 5.38829200133089874e-16, 5.35353631181331284e-16,
+	5.31961834533518774e-16, 5.28648856950170388e-16, 5.25410172417432848e-16, 5.22241633799693784e-16,
+	5.19139431175437454e-16, 5.16100055773987657e-16, 5.13120268630340445e-16, 5.10197073233815593e-16,
+	5.07327691573010954e-16, 5.04509543081526932e-16, 5.01740226071460467e-16, 4.99017501308831104e-16,
+	4.96339277440045020e-16, 4.93703598023677185e-16, 4.91108629959168123e-16, 4.88552653134998848e-16,
+	4.86034051144717136e-16, 4.83551302940785991e-16, 4.81102975314372731e-16, 4.78687716104500731e-16,
+	4.76304248052939719e-16, 4.73951363232210133e-16, 4.71627917983456082e-16, 4.69332828308951279e-16,
+	4.67065065670878982e-16, 4.64823653153934097e-16, 4.62607661954395462e-16, 4.60416208162723612e-16,
+	4.58248449810562434e-16, 4.56103584156345409e-16, 4.53980845186604040e-16, 4.51879501312603952e-16,
+	4.49798853244150578e-16, 4.47738232024346532e-16, 4.45696997210794888e-16, 4.43674535190244744e-16,
+	4.41670257615005851e-16, 4.39683599950635077e-16, 4.37714020125439172e-16, 4.35760997273262761e-16,
+	4.33824030561854377e-16, 4.31902638099835629e-16, 4.29996355915953400e-16, 4.28104737004879223e-16,
+	4.26227350434344753e-16, 4.24363780508870077e-16, 4.22513625985764556e-16, 4.20676499339458516e-16,
+	4.18852026070565572e-16, 4.17039844056383317e-16, 4.15239602939817951e-16, 4.13450963553970103e-16,
+	4.11673597379846461e-16, 4.09907186034867921e-16, 4.08151420790032439e-16, 4.06406002113760893e-16,
+	4.04670639240608137e-16, 4.02945049763163174e-16, 4.01228959245590528e-16, 3.99522100857381312e-16,
+	3.97824215025990308e-16, 3.96135049107132782e-16, 3.94454357071604140e-16, 3.92781899207567771e-16,
+	3.91117441837331251e-16, 3.89460757047700470e-16, 3.87811622433063662e-16, 3.86169820850416959e-16,
+	3.84535140185595029e-16, 3.82907373130020482e-16, 3.81286316967330994e-16, 3.79671773369284723e-16,
+	3.78063548200383327e-16, 3.76461451330687102e-16, 3.74865296456330094e-16, 3.73274900927272521e-16,
+	3.71690085581857311e-16, 3.70110674587761742e-16, 3.68536495288960153e-16, 3.66967378058335686e-16,
+	3.65403156155599338e-16, 3.63843665590193576e-16, 3.62288744988874986e-16, 3.60738235467687668e-16,
+	3.59191980508052173e-16, 3.57649825836710827e-16, 3.56111619309281267e-16, 3.54577210797182593e-16,
+	3.53046452077709579e-16, 3.51519196727039560e-16, 3.49995300015966767e-16, 3.48474618808166538e-16,
+	3.46957011460799970e-16, 3.45442337727276370e-16, 3.43930458661997454e-16, 3.42421236526912488e-16,
+	3.40914534699719578e-16, 3.39410217583552190e-16, 3.37908150517994410e-16, 3.36408199691272093e-16,
+	3.34910232053469584e-16, 3.33414115230625041e-16, 3.31919717439559035e-16, 3.30426907403292695e-16,
+	3.28935554266912732e-16, 3.27445527513742344e-16, 3.25956696881675369e-16, 3.24468932279533069e-16,
+	3.22982103703300559e-16, 3.21496081152099417e-16, 3.20010734543751511e-16, 3.18525933629786634e-16,
+	3.17041547909744450e-16, 3.15557446544617174e-16, 3.14073498269277142e-16, 3.12589571303727783e-16,
+	3.11105533263012503e-16, 3.09621251065610727e-16, 3.08136590840143359e-16, 3.06651417830204212e-16,
+	3.05165596297125703e-16, 3.03678989420478986e-16, 3.02191459196099875e-16, 3.00702866331421649e-16,
+	2.99213070137884627e-16, 2.97721928420180886e-16, 2.96229297362079170e-16, 2.94735031408560539e-16,
+	2.93238983143979692e-16, 2.91741003165950411e-16, 2.90240939954634372e-16, 2.88738639737092512e-16,
+	2.87233946346336398e-16, 2.85726701074692538e-16, 2.84216742521066931e-16, 2.82703906431668035e-16,
+	2.81188025533715876e-16, 2.79668929361630397e-16, 2.78146444075155294e-16, 2.76620392268833260e-16,
+	2.75090592772204138e-16, 2.73556860440048479e-16, 2.72019005931946727e-16, 2.70476835480365841e-16,
+	2.68930150646420617e-16, 2.67378748062387959e-16, 2.65822419159974717e-16, 2.64260949883255247e-16,
+	2.62694120385100923e-16, 2.61121704705822261e-16, 2.59543470432629109e-16, 2.57959178338390380e-16,
+	2.56368581998034762e-16, 2.54771427380780818e-16, 2.53167452416213254e-16, 2.51556386532034043e-16,
+	2.49937950161104181e-16, 2.48311854215158092e-16, 2.46677799522310060e-16, 2.45035476225178994e-16,
+	2.43384563136129436e-16, 2.41724727045758802e-16, 2.40055621980348330e-16, 2.38376888403529045e-16,
+	2.36688152356891258e-16, 2.34989024533673086e-16, 2.33279099278995066e-16, 2.31557953509347167e-16,
+	2.29825145543173298e-16, 2.28080213833415100e-16, 2.26322675591756720e-16, 2.24552025293029631e-16,
+	2.22767733046767316e-16, 2.20969242821210240e-16, 2.19155970503114587e-16, 2.17327301774469850e-16,
+	2.15482589784624560e-16, 2.13621152593291896e-16, 2.11742270356379304e-16, 2.09845182222461431e-16,
+	2.07929082902879450e-16, 2.05993118872757013e-16, 2.04036384153502002e-16, 2.02057915619395567e-16,
+	2.00056687761390634e-16, 1.98031606829916468e-16, 1.95981504264899380e-16, 1.93905129304837620e-16,
+	1.91801140646947069e-16, 1.89668097006281523e-16, 1.87504446392244542e-16, 1.85308513884656357e-16,
+	1.83078487646712558e-16, 1.80812402856403841e-16, 1.78508123168145104e-16, 1.76163319228351330e-16,
+	1.73775443656951359e-16, 1.71341701763858401e-16, 1.68859017084984223e-16, 1.66323990582380266e-16,
+	1.63732852037820870e-16, 1.61081401750818542e-16, 1.58364940090920998e-16, 1.55578181692558204e-16,
+	1.52715150033845885e-16, 1.49769046681721747e-16, 1.46732087421376441e-16, 1.43595294518214828e-16,
+	1.40348230009973348e-16, 1.36978648423155113e-16, 1.33472037365565214e-16, 1.29810998859829998e-16,
+	1.25974399143407695e-16, 1.21936172784004435e-16, 1.17663594566884712e-16, 1.13114701957502593e-16,
+	1.08234302880595287e-16, 1.02947503138165085e-16, 9.71486007609684639e-17, 9.06806040452680642e-17,
+	8.32936681517328309e-17, 7.45487048049352430e-17, 6.35435241641025848e-17, 4.77933017413775932e-17,
+};
+
+static const double gaZigNormalF[ZIGGURAT_LAYERS + 1] = {
+	4.77467764586655301e-04, 1.26028593049859797e-03, 2.60907274610636293e-03, 4.03797259337187152e-03,
+	5.52240329926475398e-03, 7.05087547139211009e-03, 8.61658276942291711e-03, 1.02149714397311003e-02,
+	1.18427578579431043e-02, 1.34974506017808069e-02, 1.51770883079820722e-02, 1.68800831525958393e-02,
+	1.86051212757833498e-02, 2.03510962301093543e-02, 2.21170627073799218e-02, 2.39022033058732368e-02,
+	2.57058040086326559e-02, 2.75272356696933153e-02, 2.93659397582301113e-02, 3.12214171920236899e-02,
+	3.30932194586886982e-02, 3.49809414618330733e-02, 3.68842156886911507e-02, 3.88027074046569179e-02,
+	4.07361106560787528e-02, 4.26841449166193779e-02, 4.46465522514465363e-02, 4.66230949020896637e-02,
+	4.86135532160351450e-02, 5.06177238611217883e-02, 5.26354182769736487e-02, 5.46664613250779155e-02,
+	5.67106901063994667e-02, 5.87679529211379836e-02, 6.08381083497518058e-02, 6.29210244379778544e-02,
+	6.50165779714704378e-02, 6.71246538280239891e-02, 6.92451443972502689e-02, 7.13779490591419652e-02,
+	7.35229737142409911e-02, 7.56801303591949637e-02, 7.78493367023722072e-02, 8.00305158149475088e-02,
+	8.22235958134956840e-02, 8.44285095706546612e-02, 8.66451944508677824e-02, 8.88735920685942288e-02,
+	9.11136480667007337e-02, 9.33653119130266190e-02, 9.56285367133533348e-02, 9.79032790392156266e-02,
+	1.00189498769172020e-01, 1.02487158942306270e-01, 1.04796225622867056e-01, 1.07116667775072880e-01,
+	1.09448457147210021e-01, 1.11791568164245583e-01, 1.14145977828255210e-01, 1.16511665626037014e-01,
+	1.18888613443345698e-01, 1.21276805485235437e-01, 1.23676228202051403e-01, 1.26086870220650349e-01,
+	1.28508722280473636e-01, 1.30941777174128166e-01, 1.33386029692162844e-01, 1.35841476571757352e-01,
+	1.38308116449064322e-01, 1.40785949814968309e-01, 1.43274978974047118e-01, 1.45775208006537926e-01,
+	1.48286642733128721e-01, 1.50809290682410169e-01, 1.53343161060837674e-01, 1.55888264725064563e-01,
+	1.58444614156520225e-01, 1.61012223438117663e-01, 1.63591108232982951e-01, 1.66181285765110071e-01,
+	1.68782774801850333e-01, 1.71395595638155623e-01, 1.74019770082499359e-01, 1.76655321444406654e-01,
+	1.79302274523530397e-01, 1.81960655600216487e-01, 1.84630492427504539e-01, 1.87311814224516926e-01,
+	1.90004651671193070e-01, 1.92709036904328807e-01, 1.95425003514885592e-01, 1.98152586546538112e-01,
+	2.00891822495431333e-01, 2.03642749311121501e-01, 2.06405406398679325e-01, 2.09179834621935651e-01,
+	2.11966076307852941e-01, 2.14764175252008499e-01, 2.17574176725178370e-01, 2.20396127481011589e-01,
+	2.23230075764789593e-01, 2.26076071323264877e-01, 2.28934165415577484e-01, 2.31804410825248525e-01,
+	2.34686861873252689e-01, 2.37581574432173676e-01, 2.40488605941449107e-01, 2.43408015423711988e-01,
+	2.46339863502238771e-01, 2.49284212419516704e-01, 2.52241126056943765e-01, 2.55210669955677150e-01,
+	2.58192911338648023e-01, 2.61187919133763713e-01, 2.64195763998317568e-01, 2.67216518344631837e-01,
+	2.70250256366959984e-01, 2.73297054069675804e-01, 2.76356989296781264e-01, 2.79430141762765316e-01,
+	2.82516593084849388e-01, 2.85616426816658109e-01, 2.88729728483353931e-01, 2.91856585618280984e-01,
+	2.94997087801162572e-01, 2.98151326697901342e-01, 3.01319396102034120e-01, 3.04501391977896274e-01,
+	3.07697412505553769e-01, 3.10907558127563710e-01, 3.14131931597630143e-01, 3.17370638031222396e-01,
+	3.20623784958230129e-01, 3.23891482377732021e-01, 3.27173842814958593e-01, 3.30470981380537099e-01,
+	3.33783015832108509e-01, 3.37110066638412809e-01, 3.40452257045945450e-01, 3.43809713148291340e-01,
+	3.47182563958251478e-01, 3.50570941482881204e-01, 3.53974980801569250e-01, 3.57394820147290515e-01,
+	3.60830600991175754e-01, 3.64282468130549597e-01, 3.67750569780596226e-01, 3.71235057669821344e-01,
+	3.74736087139491414e-01, 3.78253817247238111e-01, 3.81788410875031348e-01, 3.85340034841733958e-01,
+	3.88908860020464597e-01, 3.92495061461010764e-01, 3.96098818517547080e-01, 3.99720314981931668e-01,
+	4.03359739222868885e-01, 4.07017284331247953e-01, 4.10693148271983222e-01, 4.14387534042706784e-01,
+	4.18100649839684591e-01, 4.21832709231353298e-01, 4.25583931339900579e-01, 4.29354541031341519e-01,
+	4.33144769114574058e-01, 4.36954852549929273e-01, 4.40785034667769915e-01, 4.44635565397727750e-01,
+	4.48506701509214067e-01, 4.52398706863882505e-01, 4.56311852680773566e-01, 4.60246417814923481e-01,
+	4.64202689050278838e-01, 4.68180961407822172e-01, 4.72181538469883255e-01, 4.76204732721683788e-01,
+	4.80250865911249714e-01, 4.84320269428911598e-01, 4.88413284707712059e-01, 4.92530263646148658e-01,
+	4.96671569054796314e-01, 5.00837575128482149e-01, 5.05028667945828791e-01, 5.09245245998136142e-01,
+	5.13487720749743026e-01, 5.17756517232200619e-01, 5.22052074674794864e-01, 5.26374847174186700e-01,
+	5.30725304406193921e-01, 5.35103932383019565e-01, 5.39511234259544614e-01, 5.43947731192649941e-01,
+	5.48413963257921133e-01, 5.52910490428519918e-01, 5.57437893621486324e-01, 5.61996775817277916e-01,
+	5.66587763258951771e-01, 5.71211506738074970e-01, 5.75868682975210544e-01, 5.80559996103683473e-01,
+	5.85286179266300333e-01, 5.90047996335791969e-01, 5.94846243770991268e-01, 5.99681752622167719e-01,
+	6.04555390700549533e-01, 6.09468064928895381e-01, 6.14420723892076803e-01, 6.19414360609039205e-01,
+	6.24450015550274240e-01, 6.29528779928128279e-01, 6.34651799290960050e-01, 6.39820277456438991e-01,
+	6.45035480824251883e-01, 6.50298743114294586e-01, 6.55611470583224665e-01, 6.60975147780241357e-01,
+	6.66391343912380640e-01, 6.71861719900766374e-01, 6.77388036222513090e-01, 6.82972161648791376e-01,
+	6.88616083008527058e-01, 6.94321916130032579e-01, 7.00091918140490099e-01, 7.05928501336797409e-01,
+	7.11834248882358467e-01, 7.17811932634901395e-01, 7.23864533472881599e-01, 7.29995264565802437e-01,
+	7.36207598131266683e-01, 7.42505296344636245e-01, 7.48892447223726720e-01, 7.55373506511754500e-01,
+	7.61953346841546475e-01, 7.68637315803334831e-01, 7.75431304986138326e-01, 7.82341832659861902e-01,
+	7.89376143571198563e-01, 7.96542330428254619e-01, 8.03849483176389490e-01, 8.11307874318219935e-01,
+	8.18929191609414797e-01, 8.26726833952094231e-01, 8.34716292992930375e-01, 8.42915653118441077e-01,
+	8.51346258465123684e-01, 8.60033621203008636e-01, 8.69008688043793165e-01, 8.78309655816146839e-01,
+	8.87984660763399880e-01, 8.98095921906304051e-01, 9.08726440060562912e-01, 9.19991505048360247e-01,
+	9.32060075968990209e-01, 9.45198953453078028e-01, 9.59879091812415930e-01, 9.77101701282731328e-01,
+	1.00000000000000000e+00,
+};
+
+static const uint64_t gaZigExpK[ZIGGURAT_LAYERS] = {
+	0x1C5214272497C5, 0x1CDB4DD9E4E8C0, 0x1DDDF62BAC0BB1, 0x1E5961C78B267D,
+	0x1EA2A61E122DB2, 0x1ED38CA188151E, 0x1EF6AEFA57CBE7, 0x1F113E047B0414,
+	0x1F261434503409, 0x1F36E5A38A59A4, 0x1F44C7665C6FDB, 0x1F50724ECE1173,
+	0x1F5A66904FE3C6, 0x1F630000A8E267, 0x1F6A8234B7352C, 0x1F71200F1A241D,
+	0x1F7700A3582ACE, 0x1F7C427839E926, 0x1F80FDC336039B, 0x1F8545F904DB90,
+	0x1F892AEC479608, 0x1F8CB99E7385F8, 0x1F8FFCDA9AE41D, 0x1F92FDA9CEF1F3,
+	0x1F95C3ABD03F7A, 0x1F98555B782FB9, 0x1F9AB84415ABC5, 0x1F9CF12B79F9BD,
+	0x1F9F04336BBE0B, 0x1FA0F4F47DF316, 0x1FA2C693C5C095, 0x1FA47BD48BEA00,
+	0x1FA61726D1F213, 0x1FA79AB3508D3D, 0x1FA908656F66A2, 0x1FAA61F399FF29,
+	0x1FABA8E640060B, 0x1FACDE9DBF2D73, 0x1FAE045767E106, 0x1FAF1B31C479A7,
+	0x1FB0243042E1C3, 0x1FB1203E5A9605, 0x1FB21032442854, 0x1FB2F4CF539C40,
+	0x1FB3CEC803E747, 0x1FB49EBFBF69D3, 0x1FB5654C6F37E2, 0x1FB622F7D96943,
+	0x1FB6D840D55594, 0x1FB7859C5B895D, 0x1FB82B76765B54, 0x1FB8CA33174A18,
+	0x1FB9622ED4ABFC, 0x1FB9F3BF92B61A, 0x1FBA7F351A70AD, 0x1FBB04D9A0D18E,
+	0x1FBB84F23FE6A2, 0x1FBBFFBF63B7AA, 0x1FBC757D2C4DE5, 0x1FBCE663C6201B,
+	0x1FBD52A7B9F826, 0x1FBDBA7A354408, 0x1FBE1E094BA615, 0x1FBE7D80327DDC,
+	0x1FBED907770CC6, 0x1FBF30C52FC60D, 0x1FBF84DD294890, 0x1FBFD5710F72BA,
+	0x1FC022A092F365, 0x1FC06C898BAFF1, 0x1FC0B348184DA4, 0x1FC0F6F6BB2416,
+	0x1FC137AE74D6B8, 0x1FC17586DCCD0F, 0x1FC1B09637BB3D, 0x1FC1E8F18C6757,
+	0x1FC21EACB6D39E, 0x1FC251DA79F164, 0x1FC2828C8FFCF0, 0x1FC2B0D3B99FA0,
+	0x1FC2DCBFCBF264, 0x1FC3065FBD7888, 0x1FC32DC1B2281B, 0x1FC352F3069372,
+	0x1FC376005A4594, 0x1FC396F599614D, 0x1FC3B5DE0591B5, 0x1FC3D2C43E593E,
+	0x1FC3EDB248CB62, 0x1FC406B196BBF7, 0x1FC41DCB0D6E0E, 0x1FC433070BCB9A,
+	0x1FC4466D702E22, 0x1FC458059DC038, 0x1FC467D6817E83, 0x1FC475E696DEE7,
+	0x1FC4823BEC237A, 0x1FC48CDC265EC1, 0x1FC495CC852DF4, 0x1FC49D11E62DE3,
+	0x1FC4A2B0C82E76, 0x1FC4A6AD4E28A1, 0x1FC4A90B41FA36, 0x1FC4A9CE16EA9F,
+	0x1FC4A8F8EBFB8D, 0x1FC4A68E8E07FC, 0x1FC4A29179B434, 0x1FC49D03DD30B1,
+	0x1FC495E799D21C, 0x1FC48D3E457FF7, 0x1FC483092BFBBA, 0x1FC477495001B2,
+	0x1FC469FF6C4505, 0x1FC45B2BF447E9, 0x1FC44ACF15112B, 0x1FC438E8B5BFC7,
+	0x1FC4257877FD68, 0x1FC4107DB85061, 0x1FC3F9F78E4DA9, 0x1FC3E1E4CCAB40,
+	0x1FC3C844013349, 0x1FC3AD137497FA, 0x1FC390512A2887, 0x1FC371FADF66F8,
+	0x1FC3520E0B7EC8, 0x1FC33087DE9C0F, 0x1FC30D654122EE, 0x1FC2E8A2D2C6B5,
+	0x1FC2C23CE98046, 0x1FC29A2F906310, 0x1FC27076864FC2, 0x1FC2450D3C8400,
+	0x1FC217EED505DF, 0x1FC1E91620EA43, 0x1FC1B87D9E74B4, 0x1FC1861F770F4C,
+	0x1FC151F57D1943, 0x1FC11BF9298A65, 0x1FC0E42399698B, 0x1FC0AA6D8B1428,
+	0x1FC06ECF5B54B4, 0x1FC03141024589, 0x1FBFF1BA0FFDB2, 0x1FBFB031A904C4,
+	0x1FBF6C9E828AE3, 0x1FBF26F6DE6175, 0x1FBEDF3086B129, 0x1FBE9540C96960,
+	0x1FBE491C7364DF, 0x1FBDFAB7CB3F42, 0x1FBDAA068BD66C, 0x1FBD56FBDE729C,
+	0x1FBD018A548FA0, 0x1FBCA9A3E140D5, 0x1FBC4F39D22996, 0x1FBBF23CC8029D,
+	0x1FBB929CAEA4E4, 0x1FBB3048B49145, 0x1FBACB2F41EC17, 0x1FBA633DEEE287,
+	0x1FB9F861796F26, 0x1FB98A85BA7204, 0x1FB919959A0F74, 0x1FB8A57B0347F6,
+	0x1FB82E1ED6BA0A, 0x1FB7B368DC7DA8, 0x1FB7353FB50798, 0x1FB6B388C9010B,
+	0x1FB62E2837FE5A, 0x1FB5A500C5FDAA, 0x1FB517F3C793FE, 0x1FB486E10CACD7,
+	0x1FB3F1A6C9BE0D, 0x1FB358217F4E19, 0x1FB2BA2BDFA84B, 0x1FB2179EB29639,
+	0x1FB17050B6F1FC, 0x1FB0C41681DFF5, 0x1FB012C25B7A13, 0x1FAF5C2418B07F,
+	0x1FAEA008F21D6C, 0x1FADDE3B5782C2, 0x1FAD1682BF9FEB, 0x1FAC48A3740585,
+	0x1FAB745E588231, 0x1FAA9970ADB858, 0x1FA9B793CE5FF0, 0x1FA8CE7CE6A876,
+	0x1FA7DDDCA51EC5, 0x1FA6E55EE46782, 0x1FA5E4AA4D097F, 0x1FA4DB5FEE6AA3,
+	0x1FA3C91ACE0683, 0x1FA2AD6F6BC4FC, 0x1FA187EB3A333B, 0x1FA058140936C0,
+	0x1F9F1D6761A1CF, 0x1F9DD759CFD804, 0x1F9C85561B717A, 0x1F9B26BC697F01,
+	0x1F99BAE146BA81, 0x1F98410C968891, 0x1F96B878633894, 0x1F95204F8B64DB,
+	0x1F9377AC47AFD7, 0x1F91BD968358E2, 0x1F8FF102013E16, 0x1F8E10CC45D04B,
+	0x1F8C1BBA3D39AD, 0x1F8A10759374FC, 0x1F87ED89B24263, 0x1F85B16056B913,
+	0x1F835A3DAD9162, 0x1F80E63BE21139, 0x1F7E5346079F8A, 0x1F7B9F12413FF5,
+	0x1F78C71B045CC0, 0x1F75C8974D09D9, 0x1F72A07190F139, 0x1F6F4B3D32E4F4,
+	0x1F6BC52A2B02E7, 0x1F6809F685967A, 0x1F6414DD445770, 0x1F5FE08210D08E,
+	0x1F5B66D9099995, 0x1F56A109C3ECC1, 0x1F51874C5C3323, 0x1F4C10BF1D3A11,
+	0x1F463332D788FB, 0x1F3FE2EB6E694C, 0x1F39125157C107, 0x1F31B18FB95534,
+	0x1F29AE1951A875, 0x1F20F20C452570, 0x1F176369F1F77A, 0x1F0CE313A796B5,
+	0x1F014B76DDD4A3, 0x1EF46ECA361CCF, 0x1EE614AE6E5689, 0x1ED5F6F08799CD,
+	0x1EC3BD07B46557, 0x1EAEF5B14EF09E, 0x1E970DAF08AE3C, 0x1E7B42096F046D,
+	0x1E5A8B177CB7A0, 0x1E337B71D47835, 0x1E0409DFAC9DC8, 0x1DC934DD172C6E,
+	0x1D7E5BD56B18B2, 0x1D1BFE2D5C3970, 0x1C951D0F886513, 0x1BD127F7194472,
+	0x1A9BB7320EB09B, 0x186EF58E3F3BF1, 0x137D5BD79C3125, 0x0000000000000,
+};
+
+static const double gaZigExpW[ZIGGURAT_LAYERS] = {
+	9.65574006320918692e-16, 8.54551703858402742e-16, 7.70609535003209675e-16, 7.19244496608936156e-16,
+	6.82139307902892863e-16, 6.53049205356404080e-16, 6.29097903487755705e-16, 6.08723141618090767e-16,
+	5.90981764165210201e-16, 5.75260648150333070e-16, 5.61138745467515864e-16, 5.48314403425870293e-16,
+	5.36564097711202063e-16, 5.25717580202227484e-16, 5.15642182887808295e-16, 5.06232507214415970e-16,
+	4.97403423619193975e-16, 4.89085182739220990e-16, 4.81219917282923793e-16, 4.73759085326249203e-16,
+	4.66661566471147578e-16, 4.59892220490593247e-16, 4.53420779856583448e-16, 4.47220987425993228e-16,
+	4.41269916903607040e-16, 4.35547431469395201e-16, 4.30035748166747070e-16, 4.24719084182438505e-16,
+	4.19583367207339893e-16, 4.14615996429090458e-16, 4.09805643890306251e-16, 4.05142088295657318e-16,
+	4.00616075105654169e-16, 3.96219198078677450e-16, 3.91943798431142837e-16, 3.87782878560789480e-16,
+	3.83730027878921319e-16, 3.79779358766887389e-16, 3.75925451041625555e-16, 3.72163303608020680e-16,
+	3.68488292209562034e-16, 3.64896132376454205e-16, 3.61382846821906010e-16, 3.57944736660427605e-16,
+	3.54578355922479137e-16, 3.51280488922297892e-16, 3.48048130103744179e-16, 3.44878466045342389e-16,
+	3.41768859352563650e-16, 3.38716834204550467e-16, 3.35720063355324408e-16, 3.32776356417167141e-16,
+	3.29883649277228315e-16, 3.27039994518224044e-16, 3.24243552730945164e-16, 3.21492584620679736e-16,
+	3.18785443821971312e-16, 3.16120570346710573e-16, 3.13496484599666312e-16, 3.10911781903426585e-16,
+	3.08365127481530951e-16, 3.05855251854485989e-16, 3.03380946608500243e-16, 3.00941060501261765e-16,
+	2.98534495873004478e-16, 2.96160205334546519e-16, 2.93817188707002814e-16, 2.91504490190529318e-16,
+	2.89221195741799560e-16, 2.86966430641981768e-16, 2.84739357238817409e-16, 2.82539172848025318e-16,
+	2.80365107800698346e-16, 2.78216423624643608e-16, 2.76092411348761663e-16, 2.73992389920581482e-16,
+	2.71915704727981850e-16, 2.69861726216948893e-16, 2.67829848597952517e-16, 2.65819488634184463e-16,
+	2.63830084505494233e-16, 2.61861094742392422e-16, 2.59911997224974642e-16, 2.57982288242053090e-16,
+	2.56071481606177076e-16, 2.54179107820581223e-16, 2.52304713294421701e-16, 2.50447859602955704e-16,
+	2.48608122789585221e-16, 2.46785092706928923e-16, 2.44978372394307071e-16, 2.43187577489225596e-16,
+	2.41412335670629328e-16, 2.39652286131862401e-16, 2.37907079081427719e-16, 2.36176375269777449e-16,
+	2.34459845540495835e-16, 2.32757170404353511e-16, 2.31068039634821381e-16, 2.29392151883731135e-16,
+	2.27729214315862104e-16, 2.26078942261317374e-16, 2.24441058884630859e-16, 2.22815294869618104e-16,
+	2.21201388119049619e-16, 2.19599083468287097e-16, 2.18008132412078427e-16, 2.16428292843760522e-16,
+	2.14859328806166356e-16, 2.13301010253577958e-16, 2.11753112824107641e-16, 2.10215417621929328e-16,
+	2.08687711008816021e-16, 2.07169784404473753e-16, 2.05661434095191837e-16, 2.04162461050358951e-16,
+	2.02672670746419903e-16, 2.01191872997873516e-16, 1.99719881794934257e-16, 1.98256515147501979e-16,
+	1.96801594935103812e-16, 1.95354946762490963e-16, 1.93916399820589991e-16, 1.92485786752524431e-16,
+	1.91062943524437678e-16, 1.89647709300861697e-16, 1.88239926324389230e-16, 1.86839439799419293e-16,
+	1.85446097779756971e-16, 1.84059751059858807e-16, 1.82680253069525251e-16, 1.81307459771850181e-16,
+	1.79941229564246397e-16, 1.78581423182373287e-16, 1.77227903606800674e-16, 1.75880535972249163e-16,
+	1.74539187479253422e-16, 1.73203727308100862e-16, 1.71874026534903190e-16, 1.70549958049663008e-16,
+	1.69231396476202251e-16, 1.67918218093822911e-16, 1.66610300760574231e-16, 1.65307523838003740e-16,
+	1.64009768117271844e-16, 1.62716915746513075e-16, 1.61428850159327891e-16, 1.60145456004291698e-16,
+	1.58866619075368440e-16, 1.57592226243117663e-16, 1.56322165386583800e-16, 1.55056325325757764e-16,
+	1.53794595754499718e-16, 1.52536867173812604e-16, 1.51283030825353967e-16, 1.50032978625073720e-16,
+	1.48786603096862607e-16, 1.47543797306095188e-16, 1.46304454792947597e-16, 1.45068469505368793e-16,
+	1.43835735731579043e-16, 1.42606148031966544e-16, 1.41379601170248519e-16, 1.40155990043757154e-16,
+	1.38935209612706392e-16, 1.37717154828288121e-16, 1.36501720559439777e-16, 1.35288801518117521e-16,
+	1.34078292182899919e-16, 1.32870086720738089e-16, 1.31664078906657234e-16, 1.30460162041202885e-16,
+	1.29258228865411931e-16, 1.28058171473074938e-16, 1.26859881220039754e-16, 1.25663248630289827e-16,
+	1.24468163298511203e-16, 1.23274513788841470e-16, 1.22082187529470566e-16, 1.20891070702738503e-16,
+	1.19701048130346466e-16, 1.18512003153266894e-16, 1.17323817505904529e-16, 1.16136371184021782e-16,
+	1.14949542305900881e-16, 1.13763206966168397e-16, 1.12577239081656675e-16, 1.11391510228619676e-16,
+	1.10205889470557749e-16, 1.09020243175834986e-16, 1.07834434824194776e-16, 1.06648324801191409e-16,
+	1.05461770179457567e-16, 1.04274624485618782e-16, 1.03086737451542109e-16, 1.01897954748469334e-16,
+	1.00708117702429407e-16, 9.95170629891506325e-17, 9.83246223064950273e-17, 9.71306220222151258e-17,
+	9.59348827945798992e-17, 9.47372191631294217e-17, 9.35374391064912031e-17, 9.23353435638178073e-17,
+	9.11307259159790178e-17, 8.99233714221534844e-17, 8.87130566069024489e-17, 8.74995485921617388e-17,
+	8.62826043678410437e-17, 8.50619699938531450e-17, 8.38373797253913199e-17, 8.26085550521003078e-17,
+	8.13752036404175481e-17, 8.01370181667544704e-17, 7.88936750272978315e-17, 7.76448329079784071e-17,
+	7.63901311955081716e-17, 7.51291882072371946e-17, 7.38615992138178460e-17, 7.25869342241464096e-17,
+	7.13047354966063601e-17, 7.00145147340392222e-17, 6.87157499118380505e-17, 6.74078816787271362e-17,
+	6.60903092576939784e-17, 6.47623857595613349e-17, 6.34234128030306912e-17, 6.20726343116318609e-17,
+	6.07092293284717341e-17, 5.93323036520893692e-17, 5.79408800485276045e-17, 5.65338867323966097e-17,
+	5.51101437283508979e-17, 5.36683466171818787e-17, 5.22070470279266681e-17, 5.07246290450314147e-17,
+	4.92192804372795668e-17, 4.76889572526462916e-17, 4.61313398148317915e-17, 4.45437774328236464e-17,
+	4.29232180844251824e-17, 4.12661177817593965e-17, 3.95683219809754645e-17, 3.78249077686964165e-17,
+	3.60299697873444571e-17, 3.41763234018501902e-17, 3.22550825483636665e-17, 3.02550413032137370e-17,
+	2.81617355419774309e-17, 2.59559577231088502e-17, 2.36112807784312895e-17, 2.10896510946447615e-17,
+	1.83328488572373251e-17, 1.52439151235320246e-17, 1.16394124966910682e-17, 7.08901424395520171e-18,
+};
+
+static const double gaZigExpF[ZIGGURAT_LAYERS + 1] = {
+	1.67066692307963374e-04, 4.54134353841496603e-04, 9.67269282327174319e-04, 1.53629978030157257e-03,
+	2.14596774371890713e-03, 2.78879879357407569e-03, 3.46026477783690405e-03, 4.15729512083379705e-03,
+	4.87765598354239580e-03, 5.61964220720548909e-03, 6.38190593731918342e-03, 7.16335318363499080e-03,
+	7.96307743801704347e-03, 8.78031498580897699e-03, 9.61441364250221163e-03, 1.04648101810299807e-02,
+	1.13310135978346004e-02, 1.22125924262553778e-02, 1.31091649312549911e-02, 1.40203914031819428e-02,
+	1.49459680116911485e-02, 1.58856218399731561e-02, 1.68391068260399408e-02, 1.78062004109113547e-02,
+	1.87867007446960235e-02, 1.97804243380097396e-02, 2.07872040725781138e-02, 2.18068875042835807e-02,
+	2.28393354063852402e-02, 2.38844205115581742e-02, 2.49420264197317866e-02, 2.60120466451342208e-02,
+	2.70943837809558032e-02, 2.81889487639786461e-02, 2.92956602246374105e-02, 3.04144439104666216e-02,
+	3.15452321728936225e-02, 3.26879635089595555e-02, 3.38425821508743577e-02, 3.50090376973974313e-02,
+	3.61872847819314433e-02, 3.73772827729593818e-02, 3.85789955030748713e-02, 3.97923910233741393e-02,
+	4.10174413804148402e-02, 4.22541224133162543e-02, 4.35024135688881972e-02, 4.47622977329432889e-02,
+	4.60337610761751836e-02, 4.73167929131815615e-02, 4.86113855733795036e-02, 4.99175342827063787e-02,
+	5.12352370551262815e-02, 5.25644945930716853e-02, 5.39053101960460801e-02, 5.52576896766970305e-02,
+	5.66216412837428698e-02, 5.79971756312006592e-02, 5.93843056334202798e-02, 6.07830464454796604e-02,
+	6.21934154085410362e-02, 6.36154319998073758e-02, 6.50491177867538045e-02, 6.64944963853398158e-02,
+	6.79515934219366430e-02, 6.94204364987287825e-02, 7.09010551623718427e-02, 7.23934808757087517e-02,
+	7.38977469923647462e-02, 7.54138887340584096e-02, 7.69419431704805173e-02, 7.84819492016064352e-02,
+	8.00339475423199054e-02, 8.15979807092374193e-02, 8.31740930096323966e-02, 8.47623305323681464e-02,
+	8.63627411407569268e-02, 8.79753744672702315e-02, 8.96002819100328862e-02, 9.12375166310401969e-02,
+	9.28871335560435690e-02, 9.45491893760558727e-02, 9.62237425504328253e-02, 9.79108533114922130e-02,
+	9.96105836706371317e-02, 1.01322997425953631e-01, 1.03048160171257702e-01, 1.04786139306570159e-01,
+	1.06537004050001632e-01, 1.08300825451033755e-01, 1.10077676405185357e-01, 1.11867631670056283e-01,
+	1.13670767882744286e-01, 1.15487163578633506e-01, 1.17316899211555525e-01, 1.19160057175327641e-01,
+	1.21016721826674792e-01, 1.22886979509545108e-01, 1.24770918580830933e-01, 1.26668629437510671e-01,
+	1.28580204545228199e-01, 1.30505738468330773e-01, 1.32445327901387494e-01, 1.34399071702213602e-01,
+	1.36367070926428829e-01, 1.38349428863580176e-01, 1.40346251074862399e-01, 1.42357645432472146e-01,
+	1.44383722160634720e-01, 1.46424593878344889e-01, 1.48480375643866735e-01, 1.50551185001039839e-01,
+	1.52637142027442801e-01, 1.54738369384468027e-01, 1.56854992369365148e-01, 1.58987138969314129e-01,
+	1.61134939917591952e-01, 1.63298528751901734e-01, 1.65478041874935922e-01, 1.67673618617250081e-01,
+	1.69885401302527550e-01, 1.72113535315319977e-01, 1.74358169171353411e-01, 1.76619454590494829e-01,
+	1.78897546572478278e-01, 1.81192603475496261e-01, 1.83504787097767436e-01, 1.85834262762197083e-01,
+	1.88181199404254262e-01, 1.90545769663195363e-01, 1.92928149976771296e-01, 1.95328520679563189e-01,
+	1.97747066105098818e-01, 2.00183974691911210e-01, 2.02639439093708962e-01, 2.05113656293837654e-01,
+	2.07606827724221982e-01, 2.10119159388988230e-01, 2.12650861992978224e-01, 2.15202151075378628e-01,
+	2.17773247148700472e-01, 2.20364375843359439e-01, 2.22975768058120111e-01, 2.25607660116683956e-01,
+	2.28260293930716618e-01, 2.30933917169627356e-01, 2.33628783437433291e-01, 2.36345152457059560e-01,
+	2.39083290262449094e-01, 2.41843469398877131e-01, 2.44625969131892024e-01, 2.47431075665327543e-01,
+	2.50259082368862240e-01, 2.53110290015629402e-01, 2.55985007030415324e-01, 2.58883549749016173e-01,
+	2.61806242689362922e-01, 2.64753418835062149e-01, 2.67725419932044739e-01, 2.70722596799059967e-01,
+	2.73745309652802915e-01, 2.76793928448517301e-01, 2.79868833236972869e-01, 2.82970414538780746e-01,
+	2.86099073737076826e-01, 2.89255223489677693e-01, 2.92439288161892630e-01, 2.95651704281261252e-01,
+	2.98892921015581847e-01, 3.02163400675693528e-01, 3.05463619244590256e-01, 3.08794066934560185e-01,
+	3.12155248774179606e-01, 3.15547685227128949e-01, 3.18971912844957239e-01, 3.22428484956089223e-01,
+	3.25917972393556354e-01, 3.29440964264136438e-01, 3.32998068761809096e-01, 3.36589914028677717e-01,
+	3.40217149066780189e-01, 3.43880444704502575e-01, 3.47580494621637148e-01, 3.51318016437483449e-01,
+	3.55093752866787626e-01, 3.58908472948750001e-01, 3.62762973354817997e-01, 3.66658079781514379e-01,
+	3.70594648435146223e-01, 3.74573567615902381e-01, 3.78595759409581067e-01, 3.82662181496010056e-01,
+	3.86773829084137932e-01, 3.90931736984797384e-01, 3.95136981833290435e-01, 3.99390684475231350e-01,
+	4.03694012530530555e-01, 4.08048183152032673e-01, 4.12454465997161457e-01, 4.16914186433003209e-01,
+	4.21428728997616908e-01, 4.25999541143034677e-01, 4.30628137288459167e-01, 4.35316103215636907e-01,
+	4.40065100842354173e-01, 4.44876873414548846e-01, 4.49753251162755330e-01, 4.54696157474615836e-01,
+	4.59707615642138023e-01, 4.64789756250426511e-01, 4.69944825283960310e-01, 4.75175193037377708e-01,
+	4.80483363930454543e-01, 4.85871987341885248e-01, 4.91343869594032867e-01, 4.96901987241549881e-01,
+	5.02549501841348056e-01, 5.08289776410643213e-01, 5.14126393814748894e-01, 5.20063177368233931e-01,
+	5.26104213983620062e-01, 5.32253880263043655e-01, 5.38516872002862246e-01, 5.44898237672440056e-01,
+	5.51403416540641733e-01, 5.58038282262587892e-01, 5.64809192912400615e-01, 5.71723048664826150e-01,
+	5.78787358602845359e-01, 5.86010318477268366e-01, 5.93400901691733762e-01, 6.00968966365232560e-01,
+	6.08725382079622346e-01, 6.16682180915207878e-01, 6.24852738703666200e-01, 6.33251994214366398e-01,
+	6.41896716427266423e-01, 6.50805833414571433e-01, 6.60000841079000145e-01, 6.69506316731925177e-01,
+	6.79350572264765806e-01, 6.89566496117078431e-01, 7.00192655082788606e-01, 7.11274760805076456e-01,
+	7.22867659593572465e-01, 7.35038092431424039e-01, 7.47868621985195658e-01, 7.61463388849896838e-01,
+	7.75956852040116218e-01, 7.91527636972496285e-01, 8.08421651523009044e-01, 8.26993296643051101e-01,
+	8.47785500623990496e-01, 8.71704332381204705e-01, 9.00469929925747703e-01, 9.38143680862176477e-01,
+	1.00000000000000000e+00,
+};
+
+static const uint32_t gaZigNormalK32[ZIGGURAT_LAYERS] = {
+	0x7799ED, 0x78D2D3, 0x7B3630, 0x7C4FD3, 0x7CF4B9, 0x7D6203, 0x7DB037, 0x7DEB2D,
+	0x7E195A, 0x7E3E94, 0x7E5D47, 0x7E7711, 0x7E8D0E, 0x7EA00B, 0x7EB09E, 0x7EBF38,
+	0x7ECC30, 0x7ED7C8, 0x7EE238, 0x7EEBA9, 0x7EF43F, 0x7EFC16, 0x7F0347, 0x7F09E5,
+	0x7F1001, 0x7F15A9, 0x7F1AEA, 0x7F1FCE, 0x7F245F, 0x7F28A4, 0x7F2CA4, 0x7F3065,
+	0x7F33EE, 0x7F3741, 0x7F3A64, 0x7F3D5B, 0x7F4028, 0x7F42D0, 0x7F4553, 0x7F47B6,
+	0x7F49FB, 0x7F4C22, 0x7F4E2F, 0x7F5023, 0x7F51FF, 0x7F53C5, 0x7F5576, 0x7F5713,
+	0x7F589E, 0x7F5A17, 0x7F5B80, 0x7F5CD8, 0x7F5E22, 0x7F5F5D, 0x7F608B, 0x7F61AC,
+	0x7F62C0, 0x7F63C9, 0x7F64C6, 0x7F65B9, 0x7F66A1, 0x7F677F, 0x7F6854, 0x7F6920,
+	0x7F69E3, 0x7F6A9D, 0x7F6B4F, 0x7F6BF9, 0x7F6C9C, 0x7F6D37, 0x7F6DCC, 0x7F6E59,
+	0x7F6EE0, 0x7F6F60, 0x7F6FDA, 0x7F704E, 0x7F70BB, 0x7F7124, 0x7F7186, 0x7F71E3,
+	0x7F723B, 0x7F728D, 0x7F72DB, 0x7F7323, 0x7F7367, 0x7F73A5, 0x7F73DF, 0x7F7415,
+	0x7F7446, 0x7F7473, 0x7F749B, 0x7F74BF, 0x7F74DE, 0x7F74FA, 0x7F7511, 0x7F7525,
+	0x7F7534, 0x7F7540, 0x7F7547, 0x7F754B, 0x7F754B, 0x7F7547, 0x7F753F, 0x7F7534,
+	0x7F7525, 0x7F7512, 0x7F74FB, 0x7F74E1, 0x7F74C3, 0x7F74A2, 0x7F747C, 0x7F7454,
+	0x7F7427, 0x7F73F7, 0x7F73C3, 0x7F738C, 0x7F7351, 0x7F7312, 0x7F72D0, 0x7F728A,
+	0x7F7240, 0x7F71F2, 0x7F71A1, 0x7F714C, 0x7F70F3, 0x7F7097, 0x7F7036, 0x7F6FD1,
+	0x7F6F69, 0x7F6EFD, 0x7F6E8C, 0x7F6E17, 0x7F6D9F, 0x7F6D22, 0x7F6CA1, 0x7F6C1B,
+	0x7F6B91, 0x7F6B03, 0x7F6A70, 0x7F69D9, 0x7F693D, 0x7F689C, 0x7F67F7, 0x7F674C,
+	0x7F669D, 0x7F65E8, 0x7F652E, 0x7F646F, 0x7F63AB, 0x7F62E0, 0x7F6211, 0x7F613B,
+	0x7F6060, 0x7F5F7E, 0x7F5E96, 0x7F5DA8, 0x7F5CB3, 0x7F5BB8, 0x7F5AB6, 0x7F59AD,
+	0x7F589C, 0x7F5784, 0x7F5665, 0x7F553D, 0x7F540E, 0x7F52D6, 0x7F5195, 0x7F504C,
+	0x7F4EFA, 0x7F4D9E, 0x7F4C38, 0x7F4AC9, 0x7F494F, 0x7F47CA, 0x7F463B, 0x7F449F,
+	0x7F42F8, 0x7F4145, 0x7F3F85, 0x7F3DB8, 0x7F3BDD, 0x7F39F3, 0x7F37FB, 0x7F35F4,
+	0x7F33DC, 0x7F31B4, 0x7F2F7A, 0x7F2D2F, 0x7F2AD0, 0x7F285E, 0x7F25D7, 0x7F233B,
+	0x7F2088, 0x7F1DBD, 0x7F1ADA, 0x7F17DD, 0x7F14C5, 0x7F1190, 0x7F0E3D, 0x7F0ACA,
+	0x7F0737, 0x7F0380, 0x7EFFA4, 0x7EFBA1, 0x7EF774, 0x7EF31C, 0x7EEE95, 0x7EE9DD,
+	0x7EE4F0, 0x7EDFCB, 0x7EDA6B, 0x7ED4CC, 0x7ECEE9, 0x7EC8BD, 0x7EC243, 0x7EBB76,
+	0x7EB44F, 0x7EACC6, 0x7EA4D5, 0x7E9C73, 0x7E9396, 0x7E8A33, 0x7E803E, 0x7E75AB,
+	0x7E6A69, 0x7E5E68, 0x7E5193, 0x7E43D6, 0x7E3515, 0x7E2534, 0x7E1411, 0x7E0184,
+	0x7DED5D, 0x7DD768, 0x7DBF62, 0x7DA4FD, 0x7D87DC, 0x7D678C, 0x7D437F, 0x7D1B08,
+	0x7CED49, 0x7CB927, 0x7C7D33, 0x7C3789, 0x7BE598, 0x7B83D4, 0x7B0D30, 0x7A7A35,
+	0x79BF6C, 0x78CA39, 0x777A5D, 0x7592B0, 0x728FB4, 0x6D1AA8, 0x6045F5, 0x000000,
+};
+
+static const float gaZigNormalW32[ZIGGURAT_LAYERS] = {
+	4.661986850e-07f, 4.356089676e-07f, 4.111860221e-07f, 3.958040224e-07f,
+	3.843992999e-07f, 3.752576561e-07f, 3.675849598e-07f, 3.609463874e-07f,
+	3.550771908e-07f, 3.498037984e-07f, 3.450061286e-07f, 3.405974667e-07f,
+	3.365132102e-07f, 3.327037348e-07f, 3.291301596e-07f, 3.257614765e-07f,
+	3.225724186e-07f, 3.195422380e-07f, 3.166536260e-07f, 3.138919453e-07f,
+	3.112447757e-07f, 3.087015159e-07f, 3.062529004e-07f, 3.038908858e-07f,
+	3.016084804e-07f, 2.993994315e-07f, 2.972582536e-07f, 2.951800866e-07f,
+	2.931604968e-07f, 2.911955619e-07f, 2.892817292e-07f, 2.874157872e-07f,
+	2.855948367e-07f, 2.838162061e-07f, 2.820774512e-07f, 2.803763550e-07f,
+	2.787108713e-07f, 2.770790957e-07f, 2.754793513e-07f, 2.739099614e-07f,
+	2.723694763e-07f, 2.708565034e-07f, 2.693697354e-07f, 2.679079785e-07f,
+	2.664701242e-07f, 2.650550925e-07f, 2.636619456e-07f, 2.622897171e-07f,
+	2.609375542e-07f, 2.596046329e-07f, 2.582901857e-07f, 2.569935020e-07f,
+	2.557138998e-07f, 2.544506970e-07f, 2.532032966e-07f, 2.519711302e-07f,
+	2.507536578e-07f, 2.495503111e-07f, 2.483606067e-07f, 2.471840617e-07f,
+	2.460202495e-07f, 2.448687439e-07f, 2.437291187e-07f, 2.426009473e-07f,
+	2.414839173e-07f, 2.403776307e-07f, 2.392817464e-07f, 2.381959519e-07f,
+	2.371199201e-07f, 2.360533387e-07f, 2.349959232e-07f, 2.339474037e-07f,
+	2.329074960e-07f, 2.318759584e-07f, 2.308525353e-07f, 2.298369850e-07f,
+	2.288290659e-07f, 2.278285649e-07f, 2.268352688e-07f, 2.258489786e-07f,
+	2.248694670e-07f, 2.238965635e-07f, 2.229300691e-07f, 2.219697990e-07f,
+	2.210155827e-07f, 2.200672498e-07f, 2.191246296e-07f, 2.181875658e-07f,
+	2.172559022e-07f, 2.163294823e-07f, 2.154081642e-07f, 2.144917914e-07f,
+	2.135802504e-07f, 2.126733847e-07f, 2.117710665e-07f, 2.108731820e-07f,
+	2.099795751e-07f, 2.090901461e-07f, 2.082047814e-07f, 2.073233389e-07f,
+	2.064457334e-07f, 2.055718369e-07f, 2.047015357e-07f, 2.038347304e-07f,
+	2.029713215e-07f, 2.021112095e-07f, 2.012542666e-07f, 2.004004358e-07f,
+	1.995495893e-07f, 1.987016560e-07f, 1.978565223e-07f, 1.970141170e-07f,
+	1.961743266e-07f, 1.953370798e-07f, 1.945022916e-07f, 1.936698624e-07f,
+	1.928397211e-07f, 1.920117825e-07f, 1.911859755e-07f, 1.903621865e-07f,
+	1.895403727e-07f, 1.887204348e-07f, 1.879023017e-07f, 1.870858881e-07f,
+	1.862711230e-07f, 1.854579494e-07f, 1.846462538e-07f, 1.838360077e-07f,
+	1.830270975e-07f, 1.822194662e-07f, 1.814130570e-07f, 1.806077705e-07f,
+	1.798035640e-07f, 1.790003381e-07f, 1.781980359e-07f, 1.773966005e-07f,
+	1.765959325e-07f, 1.757959751e-07f, 1.749966714e-07f, 1.741979361e-07f,
+	1.733996982e-07f, 1.726019008e-07f, 1.718044587e-07f, 1.710073150e-07f,
+	1.702103845e-07f, 1.694136103e-07f, 1.686169213e-07f, 1.678202466e-07f,
+	1.670235150e-07f, 1.662266413e-07f, 1.654295687e-07f, 1.646322261e-07f,
+	1.638345282e-07f, 1.630364181e-07f, 1.622378107e-07f, 1.614386207e-07f,
+	1.606387912e-07f, 1.598382369e-07f, 1.590368868e-07f, 1.582346698e-07f,
+	1.574314865e-07f, 1.566272516e-07f, 1.558219225e-07f, 1.550153712e-07f,
+	1.542075552e-07f, 1.533983607e-07f, 1.525877025e-07f, 1.517755095e-07f,
+	1.509616681e-07f, 1.501461071e-07f, 1.493287414e-07f, 1.485094430e-07f,
+	1.476881408e-07f, 1.468647213e-07f, 1.460390848e-07f, 1.452111462e-07f,
+	1.443807776e-07f, 1.435478794e-07f, 1.427123237e-07f, 1.418740112e-07f,
+	1.410328281e-07f, 1.401886465e-07f, 1.393413385e-07f, 1.384907762e-07f,
+	1.376368317e-07f, 1.367793629e-07f, 1.359182420e-07f, 1.350533125e-07f,
+	1.341844182e-07f, 1.333114170e-07f, 1.324341383e-07f, 1.315524258e-07f,
+	1.306660948e-07f, 1.297749748e-07f, 1.288788809e-07f, 1.279776143e-07f,
+	1.270709902e-07f, 1.261587670e-07f, 1.252407600e-07f, 1.243167276e-07f,
+	1.233864424e-07f, 1.224496344e-07f, 1.215060621e-07f, 1.205554554e-07f,
+	1.195975159e-07f, 1.186319594e-07f, 1.176584661e-07f, 1.166767092e-07f,
+	1.156863334e-07f, 1.146869835e-07f, 1.136782686e-07f, 1.126597766e-07f,
+	1.116310742e-07f, 1.105917136e-07f, 1.095411974e-07f, 1.084790142e-07f,
+	1.074046168e-07f, 1.063174082e-07f, 1.052167704e-07f, 1.041020212e-07f,
+	1.029724501e-07f, 1.018272826e-07f, 1.006656802e-07f, 9.948674773e-08f,
+	9.828951164e-08f, 9.707292037e-08f, 9.583581573e-08f, 9.457696137e-08f,
+	9.329497885e-08f, 9.198837603e-08f, 9.065549733e-08f, 8.929450956e-08f,
+	8.790340900e-08f, 8.647992189e-08f, 8.502153293e-08f, 8.352539993e-08f,
+	8.198831836e-08f, 8.040664312e-08f, 7.877618913e-08f, 7.709213889e-08f,
+	7.534887914e-08f, 7.353985154e-08f, 7.165725435e-08f, 6.969175104e-08f,
+	6.763198712e-08f, 6.546398623e-08f, 6.317016243e-08f, 6.072799152e-08f,
+	5.810784742e-08f, 5.526952052e-08f, 5.215625620e-08f, 4.868377701e-08f,
+	4.471794668e-08f, 4.002303200e-08f, 3.411467020e-08f, 2.565883328e-08f,
+};
+
+static const uint32_t gaZigExpK32[ZIGGURAT_LAYERS] = {
+	0xE290A2, 0xE6DA6F, 0xEEEFB2, 0xF2CB0F, 0xF51531, 0xF69C66, 0xF7B578, 0xF889F1,
+	0xF930A2, 0xF9B72E, 0xFA263C, 0xFA8393, 0xFAD335, 0xFB1801, 0xFB5412, 0xFB8901,
+	0xFBB806, 0xFBE214, 0xFC07EF, 0xFC2A30, 0xFC4958, 0xFC65CD, 0xFC7FE7, 0xFC97EE,
+	0xFCAE1E, 0xFCC2AB, 0xFCD5C3, 0xFCE78A, 0xFCF822, 0xFD07A8, 0xFD1635, 0xFD23DF,
+	0xFD30BA, 0xFD3CD6, 0xFD4844, 0xFD5310, 0xFD5D48, 0xFD66F5, 0xFD7023, 0xFD78DA,
+	0xFD8122, 0xFD8902, 0xFD9082, 0xFD97A7, 0xFD9E77, 0xFDA4F6, 0xFDAB2B, 0xFDB118,
+	0xFDB6C3, 0xFDBC2D, 0xFDC15C, 0xFDC652, 0xFDCB12, 0xFDCF9E, 0xFDD3FA, 0xFDD827,
+	0xFDDC28, 0xFDDFFE, 0xFDE3AC, 0xFDE734, 0xFDEA96, 0xFDEDD4, 0xFDF0F1, 0xFDF3ED,
+	0xFDF6C9, 0xFDF987, 0xFDFC27, 0xFDFEAC, 0xFE0116, 0xFE0365, 0xFE059B, 0xFE07B8,
+	0xFE09BE, 0xFE0BAD, 0xFE0D85, 0xFE0F48, 0xFE10F6, 0xFE128F, 0xFE1415, 0xFE1587,
+	0xFE16E6, 0xFE1833, 0xFE196F, 0xFE1A98, 0xFE1BB1, 0xFE1CB8, 0xFE1DAF, 0xFE1E97,
+	0xFE1F6E, 0xFE2036, 0xFE20EF, 0xFE2199, 0xFE2234, 0xFE22C1, 0xFE233F, 0xFE23B0,
+	0xFE2412, 0xFE2467, 0xFE24AF, 0xFE24E9, 0xFE2516, 0xFE2536, 0xFE2549, 0xFE254F,
+	0xFE2548, 0xFE2535, 0xFE2515, 0xFE24E9, 0xFE24B0, 0xFE246A, 0xFE2419, 0xFE23BB,
+	0xFE2350, 0xFE22DA, 0xFE2257, 0xFE21C8, 0xFE212C, 0xFE2084, 0xFE1FD0, 0xFE1F10,
+	0xFE1E43, 0xFE1D69, 0xFE1C83, 0xFE1B90, 0xFE1A91, 0xFE1985, 0xFE186C, 0xFE1746,
+	0xFE1612, 0xFE14D2, 0xFE1384, 0xFE1229, 0xFE10C0, 0xFE0F49, 0xFE0DC4, 0xFE0C31,
+	0xFE0A90, 0xFE08E0, 0xFE0722, 0xFE0554, 0xFE0377, 0xFE018B, 0xFDFF8E, 0xFDFD82,
+	0xFDFB65, 0xFDF938, 0xFDF6FA, 0xFDF4AB, 0xFDF249, 0xFDEFD6, 0xFDED51, 0xFDEAB8,
+	0xFDE80D, 0xFDE54E, 0xFDE27A, 0xFDDF92, 0xFDDC95, 0xFDD983, 0xFDD65A, 0xFDD31A,
+	0xFDCFC4, 0xFDCC55, 0xFDC8CD, 0xFDC52C, 0xFDC171, 0xFDBD9C, 0xFDB9AA, 0xFDB59D,
+	0xFDB172, 0xFDAD29, 0xFDA8C0, 0xFDA438, 0xFD9F8E, 0xFD9AC2, 0xFD95D2, 0xFD90BD,
+	0xFD8B83, 0xFD8621, 0xFD8097, 0xFD7AE2, 0xFD7501, 0xFD6EF2, 0xFD68B5, 0xFD6246,
+	0xFD5BA3, 0xFD54CC, 0xFD4DBD, 0xFD4674, 0xFD3EEF, 0xFD372B, 0xFD2F26, 0xFD26DB,
+	0xFD1E49, 0xFD156C, 0xFD0C40, 0xFD02C1, 0xFCF8EC, 0xFCEEBB, 0xFCE42B, 0xFCD936,
+	0xFCCDD8, 0xFCC209, 0xFCB5C4, 0xFCA903, 0xFC9BBE, 0xFC8DED, 0xFC7F89, 0xFC7087,
+	0xFC60DE, 0xFC5084, 0xFC3F6D, 0xFC2D8C, 0xFC1AD2, 0xFC0732, 0xFBF29B, 0xFBDCF9,
+	0xFBC639, 0xFBAE45, 0xFB9504, 0xFB7A5A, 0xFB5E2A, 0xFB4050, 0xFB20A7, 0xFAFF05,
+	0xFADB37, 0xFAB509, 0xFA8C3B, 0xFA6086, 0xFA319A, 0xF9FF18, 0xF9C893, 0xF98D8D,
+	0xF94D71, 0xF90791, 0xF8BB1C, 0xF86719, 0xF80A5C, 0xF7A377, 0xF730A6, 0xF6AFB8,
+	0xF61DE9, 0xF577AE, 0xF4B86E, 0xF3DA11, 0xF2D459, 0xF19BDC, 0xF0204F, 0xEE49A7,
+	0xEBF2DF, 0xE8DFF2, 0xE4A8E9, 0xDE8940, 0xD4DDBA, 0xC377AD, 0x9BEADF, 0x000000,
+};
+
+static const float gaZigExpW32[ZIGGURAT_LAYERS] = {
+	5.183886174e-07f, 4.587839442e-07f, 4.137178564e-07f, 3.861414370e-07f,
+	3.662207462e-07f, 3.506031305e-07f, 3.377443534e-07f, 3.268057469e-07f,
+	3.172809215e-07f, 3.088406970e-07f, 3.012590639e-07f, 2.943740469e-07f,
+	2.880656496e-07f, 2.822424676e-07f, 2.768332763e-07f, 2.717815164e-07f,
+	2.670414290e-07f, 2.625756110e-07f, 2.583529692e-07f, 2.543474693e-07f,
+	2.505370276e-07f, 2.469027436e-07f, 2.434284170e-07f, 2.400999506e-07f,
+	2.369049810e-07f, 2.338327505e-07f, 2.308736811e-07f, 2.280193172e-07f,
+	2.252620988e-07f, 2.225952613e-07f, 2.200127227e-07f, 2.175089975e-07f,
+	2.150791119e-07f, 2.127185610e-07f, 2.104232237e-07f, 2.081893484e-07f,
+	2.060134960e-07f, 2.038924976e-07f, 2.018234397e-07f, 1.998036510e-07f,
+	1.978306443e-07f, 1.959021176e-07f, 1.940159393e-07f, 1.921701198e-07f,
+	1.903628117e-07f, 1.885922813e-07f, 1.868569228e-07f, 1.851552156e-07f,
+	1.834857528e-07f, 1.818472128e-07f, 1.802383309e-07f, 1.786579418e-07f,
+	1.771049369e-07f, 1.755782648e-07f, 1.740769306e-07f, 1.726000107e-07f,
+	1.711466382e-07f, 1.697159320e-07f, 1.683071389e-07f, 1.669194916e-07f,
+	1.655522652e-07f, 1.642047920e-07f, 1.628764039e-07f, 1.615665042e-07f,
+	1.602744817e-07f, 1.589997964e-07f, 1.577419084e-07f, 1.565002776e-07f,
+	1.552744493e-07f, 1.540639261e-07f, 1.528682816e-07f, 1.516870611e-07f,
+	1.505198668e-07f, 1.493663007e-07f, 1.482259790e-07f, 1.470985467e-07f,
+	1.459836341e-07f, 1.448809144e-07f, 1.437900607e-07f, 1.427107463e-07f,
+	1.416427011e-07f, 1.405855983e-07f, 1.395391962e-07f, 1.385031823e-07f,
+	1.374773291e-07f, 1.364613667e-07f, 1.354550676e-07f, 1.344581761e-07f,
+	1.334704649e-07f, 1.324917349e-07f, 1.315217588e-07f, 1.305603377e-07f,
+	1.296072583e-07f, 1.286623359e-07f, 1.277253858e-07f, 1.267962233e-07f,
+	1.258746778e-07f, 1.249605504e-07f, 1.240537131e-07f, 1.231539670e-07f,
+	1.222611843e-07f, 1.213752086e-07f, 1.204958693e-07f, 1.196230528e-07f,
+	1.187565886e-07f, 1.178963629e-07f, 1.170422266e-07f, 1.161940517e-07f,
+	1.153517246e-07f, 1.145151103e-07f, 1.136840879e-07f, 1.128585438e-07f,
+	1.120383644e-07f, 1.112234287e-07f, 1.104136444e-07f, 1.096088837e-07f,
+	1.088090613e-07f, 1.080140635e-07f, 1.072237978e-07f, 1.064381578e-07f,
+	1.056570511e-07f, 1.048803853e-07f, 1.041080750e-07f, 1.033400210e-07f,
+	1.025761378e-07f, 1.018163402e-07f, 1.010605430e-07f, 1.003086609e-07f,
+	9.956061575e-08f, 9.881632934e-08f, 9.807571644e-08f, 9.733869888e-08f,
+	9.660521272e-08f, 9.587517269e-08f, 9.514850774e-08f, 9.442514681e-08f,
+	9.370501175e-08f, 9.298804571e-08f, 9.227416342e-08f, 9.156330805e-08f,
+	9.085541564e-08f, 9.015040803e-08f, 8.944822127e-08f, 8.874879853e-08f,
+	8.805207585e-08f, 8.735798218e-08f, 8.666645357e-08f, 8.597744028e-08f,
+	8.529086415e-08f, 8.460668255e-08f, 8.392482442e-08f, 8.324523293e-08f,
+	8.256784412e-08f, 8.189260825e-08f, 8.121946138e-08f, 8.054833955e-08f,
+	7.987920014e-08f, 7.921197209e-08f, 7.854660566e-08f, 7.788304401e-08f,
+	7.722122319e-08f, 7.656109346e-08f, 7.590259798e-08f, 7.524567280e-08f,
+	7.459027529e-08f, 7.393633439e-08f, 7.328380036e-08f, 7.263262347e-08f,
+	7.198273266e-08f, 7.133408531e-08f, 7.068661745e-08f, 7.004026514e-08f,
+	6.939498576e-08f, 6.875070824e-08f, 6.810738284e-08f, 6.746494563e-08f,
+	6.682333975e-08f, 6.618250126e-08f, 6.554237331e-08f, 6.490289906e-08f,
+	6.426400745e-08f, 6.362564875e-08f, 6.298774480e-08f, 6.235023875e-08f,
+	6.171306666e-08f, 6.107615746e-08f, 6.043944722e-08f, 5.980286488e-08f,
+	5.916633583e-08f, 5.852979612e-08f, 5.789317115e-08f, 5.725638275e-08f,
+	5.661935631e-08f, 5.598201369e-08f, 5.534426961e-08f, 5.470604947e-08f,
+	5.406725734e-08f, 5.342781506e-08f, 5.278763027e-08f, 5.214660703e-08f,
+	5.150464943e-08f, 5.086165800e-08f, 5.021752969e-08f, 4.957216149e-08f,
+	4.892543615e-08f, 4.827724354e-08f, 4.762745931e-08f, 4.697596268e-08f,
+	4.632262218e-08f, 4.566729572e-08f, 4.500985185e-08f, 4.435013068e-08f,
+	4.368797946e-08f, 4.302323475e-08f, 4.235571893e-08f, 4.168525081e-08f,
+	4.101163853e-08f, 4.033467604e-08f, 3.965414308e-08f, 3.896981227e-08f,
+	3.828143846e-08f, 3.758875522e-08f, 3.689148897e-08f, 3.618933064e-08f,
+	3.548196403e-08f, 3.476904098e-08f, 3.405018489e-08f, 3.332499077e-08f,
+	3.259301806e-08f, 3.185378716e-08f, 3.110677227e-08f, 3.035139784e-08f,
+	2.958703327e-08f, 2.881297334e-08f, 2.802844534e-08f, 2.723257708e-08f,
+	2.642440045e-08f, 2.560281409e-08f, 2.476657457e-08f, 2.391425902e-08f,
+	2.304422786e-08f, 2.215457862e-08f, 2.124308196e-08f, 2.030709290e-08f,
+	1.934344240e-08f, 1.834827401e-08f, 1.731681643e-08f, 1.624305135e-08f,
+	1.511921610e-08f, 1.393499893e-08f, 1.267620942e-08f, 1.132242033e-08f,
+	9.842373139e-09f, 8.184014355e-09f, 6.248861872e-09f, 3.805885385e-09f,
+};
+
+/* Slow paths */
+
+// Uniform in (0, 1], safe for log
+static inline double ziggurat_open01_64(rand64_func_t rand64_function, rand64_state* state) {
+	return (double)((rand64_function(state) >> 11) + 1) * 0x1p-53;
+}
+
+static inline float ziggurat_open01_32(rand32_func_t rand32_function, rand32_state* state) {
+	return (float)((rand32_function(state) >> 8) + 1) * 0x1p-24f;
+}
+
+// Uniform in [0, 1)
+static inline double ziggurat_unit64(rand64_func_t rand64_function, rand64_state* state) {
+	return (double)(rand64_function(state) >> 11) * 0x1p-53;
+}
+
+static inline float ziggurat_unit32(rand32_func_t rand32_function, rand32_state* state) {
+	return (float)(rand32_function(state) >> 8) * 0x1p-24f;
+}
+
+// Marsaglia's tail method: R + x with x ~ exp(-R x), accepted with probability exp(-x^2 / 2)
+static double ziggurat_normal_tail64(rand64_func_t rand64_function, rand64_state* state, uint8_t negative) {
+	double x;
+	double y;
+	do {
+		x = log(ziggurat_open01_64(rand64_function, state)) / ZIGGURAT_NORMAL_R;
+		y = log(ziggurat_open01_64(rand64_function, state));
+	} while (-2.0 * y < x * x);
+	return negative ? x - ZIGGURAT_NORMAL_R : ZIGGURAT_NORMAL_R - x;
+}
+
+static float ziggurat_normal_tail32(rand32_func_t rand32_function, rand32_state* state, uint8_t negative) {
+	float x;
+	float y;
+	do {
+		x = logf(ziggurat_open01_32(rand32_function, state)) / (float)ZIGGURAT_NORMAL_R;
+		y = logf(ziggurat_open01_32(rand32_function, state));
+	} while (-2.0f * y < x * x);
+	return negative ? x - (float)ZIGGURAT_NORMAL_R : (float)ZIGGURAT_NORMAL_R - x;
+}
+
+/* 64-bit RNG */
+
+// Standard normal (mean 0, variance 1)
+static inline double randn64(rand64_func_t rand64_function, rand64_state* state) {
+	for (;;) {
+		uint64_t bits = rand64_function(state);
+		uint8_t i = (uint8_t)bits;
+		uint64_t m = (bits >> 11) & ((1ull << ZIGGURAT_NORMAL_BITS) - 1);
+		uint8_t negative = (uint8_t)(bits >> 63);
+		if (m < gaZigNormalK[i]) {
+			double x = (double)m * gaZigNormalW[i];
+			return negative ? -x : x;
+		}
+		if (i == 0)
+			return ziggurat_normal_tail64(rand64_function, state, negative);
+		double x = (double)m * gaZigNormalW[i];
+		if (gaZigNormalF[i + 1] + (gaZigNormalF[i] - gaZigNormalF[i + 1]) * ziggurat_unit64(rand64_function, state) < exp(-0.5 * x * x))
+			return negative ? -x : x;
+	}
+}
+
+// Standard exponential (rate 1)
+static inline double rande64(rand64_func_t rand64_function, rand64_state* state) {
+	for (;;) {
+		uint64_t bits = rand64_function(state);
+		uint8_t i = (uint8_t)bits;
+		uint64_t m = bits >> 11;
+		if (m < gaZigExpK[i])
+			return (double)m * gaZigExpW[i];
+		if (i == 0)
+			return ZIGGURAT_EXP_R - log(ziggurat_open01_64(rand64_function, state));
+		double x = (double)m * gaZigExpW[i];
+		if (gaZigExpF[i + 1] + (gaZigExpF[i] - gaZigExpF[i + 1]) * ziggurat_unit64(rand64_function, state) < exp(-x))
+			return x;
+	}
+}
+
+static void randn64_fill(rand64_func_t rand64_function, rand64_state* state, double aOut[], size_t count) {
+	for (size_t i = 0; i < count; ++i)
+		aOut[i] = randn64(rand64_function, state);
+}
+
+static void rande64_fill(rand64_func_t rand64_function, rand64_state* state, double aOut[], size_t count) {
+	for (size_t i = 0; i < count; ++i)
+		aOut[i] = rande64(rand64_function, state);
+}
+
+/* 32-bit RNG */
+
+static inline float randn32(rand32_func_t rand32_function, rand32_state* state) {
+	for (;;) {
+		uint32_t bits = rand32_function(state);
+		uint8_t i = (uint8_t)bits;
+		uint32_t m = (bits >> 8) & ((1u << ZIGGURAT_NORMAL_BITS32) - 1);
+		uint8_t negative = (uint8_t)(bits >> 31);
+		if (m < gaZigNormalK32[i]) {
+			float x = (float)m * gaZigNormalW32[i];
+			return negative ? -x : x;
+		}
+		if (i == 0)
+			return ziggurat_normal_tail32(rand32_function, state, negative);
+		float x = (float)m * gaZigNormalW32[i];
+		if ((float)gaZigNormalF[i + 1] + (float)(gaZigNormalF[i] - gaZigNormalF[i + 1]) * ziggurat_unit32(rand32_function, state) < expf(-0.5f * x * x))
+			return negative ? -x : x;
+	}
+}
+
+static inline float rande32(rand32_func_t rand32_function, rand32_state* state) {
+	for (;;) {
+		uint32_t bits = rand32_function(state);
+		uint8_t i = (uint8_t)bits;
+		uint32_t m = bits >> 8;
+		if (m < gaZigExpK32[i])
+			return (float)m * gaZigExpW32[i];
+		if (i == 0)
+			return (float)ZIGGURAT_EXP_R - logf(ziggurat_open01_32(rand32_function, state));
+		float x = (float)m * gaZigExpW32[i];
+		if ((float)gaZigExpF[i + 1] + (float)(gaZigExpF[i] - gaZigExpF[i + 1]) * ziggurat_unit32(rand32_function, state) < expf(-x))
+			return x;
+	}
+}
+
+static void randn32_fill(rand32_func_t rand32_function, rand32_state* state, float aOut[], size_t count) {
+	for (size_t i = 0; i < count; ++i)
+		aOut[i] = randn32(rand32_function, state);
+}
+
+static void rande32_fill(rand32_func_t rand32_function, rand32_state* state, float aOut[], size_t count) {
+	for (size_t i = 0; i < count; ++i)
+		aOut[i] = rande32(rand32_function, state);
+}
+
+/* Table self-check */
+
+// Rebuilds every table entry from X[i] = W[i] 2^b and the equal-area definition:
+// F[i] = f(X[i]), every layer has area V (X[0] F[1] for the base, X[i] (F[i + 1] - F[i]) above it,
+// with V = R f(R) + the tail integral), and K, W32 and K32 follow exactly from X.
+// Returns the largest relative error of the F and area checks, or INFINITY if an exact entry differs.
+// The top layer closes the recursion (F[256] = 1) and absorbs the rounding of R, ~1e-9 here.
+#define ZIGGURAT_CHECK_TOLERANCE 1e-8
+
+static double ziggurat_check_table(const uint64_t aK[], const double aW[], const double aF[],
+	const uint32_t aK32[], const float aW32[], int bits, int bits32, uint8_t normal) {
+	double r = normal ? ZIGGURAT_NORMAL_R : ZIGGURAT_EXP_R;
+	double fR = normal ? exp(-0.5 * r * r) : exp(-r);
+	double v = normal ? r * fR + 1.25331413731550025 * erfc(r / sqrt(2.0)) /* sqrt(pi / 2) */ : r * fR + fR;
+	double maxError = fabs(aF[1] - fR) / fR;
+	for (int i = 0; i < ZIGGURAT_LAYERS; ++i) {
+		double x = ldexp(aW[i], bits);
+		double xNext = i + 1 < ZIGGURAT_LAYERS ? ldexp(aW[i + 1], bits) : 0.0;
+		double f = normal ? exp(-0.5 * x * x) : exp(-x);
+		double area = i == 0 ? x * aF[1] : x * (aF[i + 1] - aF[i]);
+		maxError = fmax(maxError, fabs(aF[i] - f) / f);
+		maxError = fmax(maxError, fabs(area - v) / v);
+		if (aK[i] != (uint64_t)ceil(ldexp(xNext / x, bits)))
+			return INFINITY;
+		if (aK32[i] != (uint32_t)ceil(ldexp(xNext / x, bits32)))
+			return INFINITY;
+		if (aW32[i] != (float)ldexp(x, -bits32))
+			return INFINITY;
+	}
+	if (aF[ZIGGURAT_LAYERS] != 1.0)
+		return INFINITY;
+	return maxError;
+}
+
+static double ziggurat_check(void) {
+	double normalError = ziggurat_check_table(gaZigNormalK, gaZigNormalW, gaZigNormalF,
+		gaZigNormalK32, gaZigNormalW32, ZIGGURAT_NORMAL_BITS, ZIGGURAT_NORMAL_BITS32, 1);
+	double expError = ziggurat_check_table(gaZigExpK, gaZigExpW, gaZigExpF,
+		gaZigExpK32, gaZigExpW32, ZIGGURAT_EXP_BITS, ZIGGURAT_EXP_BITS32, 0);
+	return fmax(normalError, expError);
+}